@@ -91,6 +91,10 @@ namespace embree
       return Vec3fa(_mm_loadu_ps((float*)a));
     }
 
+    static __forceinline Vec3fa loadu_half( const void* const a ) {
+      return Vec3fa(vfloat4::load_half(a));
+    }
+
     static __forceinline void storeu ( void* ptr, const Vec3fa& v ) {
       _mm_storeu_ps((float*)ptr,v);
     }
@@ -151,7 +151,30 @@ namespace embree
     static __forceinline vfloat4 load(const unsigned short* ptr) {
       return _mm_mul_ps(vfloat4(vint4::load(ptr)),vfloat4(1.0f/65535.0f));
     }
-    
+
+    /* loads and converts 4 half precision floats */
+    static __forceinline vfloat4 load_half(const void* ptr)
+    {
+#if defined(__F16C__)
+      return _mm_cvtph_ps(_mm_loadl_epi64((__m128i*)ptr));
+#else
+      const __m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64((__m128i*)ptr),_mm_setzero_si128());
+      const __m128i shifted_exp = _mm_set1_epi32(0x7c00 << 13);
+      const __m128i em  = _mm_slli_epi32(_mm_and_si128(h,_mm_set1_epi32(0x7fff)),13);
+      const __m128i exp = _mm_and_si128(em,shifted_exp);
+      __m128i o = _mm_add_epi32(em,_mm_set1_epi32((127-15) << 23));
+      /* adjust exponent of infinity and NaN */
+      o = _mm_add_epi32(o,_mm_and_si128(_mm_cmpeq_epi32(exp,shifted_exp),_mm_set1_epi32((128-16) << 23)));
+      /* renormalize zero and denormals */
+      const __m128 denorm = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o,_mm_set1_epi32(1 << 23))),_mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+      const __m128 is_denorm = _mm_castsi128_ps(_mm_cmpeq_epi32(exp,_mm_setzero_si128()));
+      const __m128 f = _mm_or_ps(_mm_and_ps(is_denorm,denorm),_mm_andnot_ps(is_denorm,_mm_castsi128_ps(o)));
+      return _mm_or_ps(f,_mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h,_mm_set1_epi32(0x8000)),16)));
+#endif
+    }
+
+    static __forceinline vfloat4 load_half(const vboolf4& mask, const void* ptr) { return _mm_and_ps(load_half(ptr),mask); }
+
     static __forceinline void store_nt(void* ptr, const vfloat4& v)
     {
 #if defined (__SSE4_1__)
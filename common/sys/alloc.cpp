@@ -175,6 +175,14 @@ namespace embree
   void os_advise(void *ptr, size_t bytes)
   {
   }
+
+  bool os_numa_interleave(void* ptr, size_t bytes) {
+    return false;
+  }
+
+  bool os_numa_bind(void* ptr, size_t bytes, size_t node) {
+    return false;
+  }
 }
 
 #endif
@@ -195,6 +203,11 @@ namespace embree
 #include <mach/vm_statistics.h>
 #endif
 
+#if defined(__LINUX__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
 namespace embree
 {
   bool os_init(bool hugepages, bool verbose) 
@@ -314,6 +327,54 @@ namespace embree
     madvise(pptr,bytes,MADV_HUGEPAGE); 
 #endif
   }
+
+#if defined(__LINUX__) && defined(SYS_mbind)
+
+  /* memory policies of the mbind system call */
+  static const int MPOL_PREFERRED_  = 1;
+  static const int MPOL_INTERLEAVE_ = 3;
+
+  static bool os_mbind(void* ptr, size_t bytes, int mode, const unsigned long* nodemask, size_t maxnode)
+  {
+    /* the policy can only be set for full pages inside the range */
+    const size_t begin = ((size_t)ptr + PAGE_SIZE_4K-1) & ~size_t(PAGE_SIZE_4K-1);
+    const size_t end   = ((size_t)ptr + bytes) & ~size_t(PAGE_SIZE_4K-1);
+    if (end <= begin) return false;
+    return syscall(SYS_mbind,begin,end-begin,mode,nodemask,maxnode,0) == 0;
+  }
+
+  bool os_numa_interleave(void* ptr, size_t bytes)
+  {
+    const size_t numNodes = getNumberOfNumaNodes();
+    if (numNodes <= 1) return false;
+    
+    unsigned long nodemask[16] = { 0 };
+    for (size_t i=0; i<numNodes && i<8*sizeof(nodemask); i++)
+      nodemask[i/(8*sizeof(unsigned long))] |= 1ul << (i%(8*sizeof(unsigned long)));
+    return os_mbind(ptr,bytes,MPOL_INTERLEAVE_,nodemask,8*sizeof(nodemask)+1);
+  }
+
+  bool os_numa_bind(void* ptr, size_t bytes, size_t node)
+  {
+    if (getNumberOfNumaNodes() <= 1 || node >= 8*16*sizeof(unsigned long)) return false;
+    
+    /* the preferred policy falls back to other nodes when the node runs out of memory */
+    unsigned long nodemask[16] = { 0 };
+    nodemask[node/(8*sizeof(unsigned long))] = 1ul << (node%(8*sizeof(unsigned long)));
+    return os_mbind(ptr,bytes,MPOL_PREFERRED_,nodemask,8*sizeof(nodemask)+1);
+  }
+
+#else
+
+  bool os_numa_interleave(void* ptr, size_t bytes) {
+    return false;
+  }
+
+  bool os_numa_bind(void* ptr, size_t bytes, size_t node) {
+    return false;
+  }
+
+#endif
 }
 
 #endif
@@ -74,6 +74,10 @@ namespace embree
   void  os_free   (void* ptr, size_t bytes, bool hugepages);
   void  os_advise (void* ptr, size_t bytes);
 
+  /*! NUMA placement of memory pages that are not yet touched */
+  bool os_numa_interleave (void* ptr, size_t bytes);
+  bool os_numa_bind (void* ptr, size_t bytes, size_t node);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
@@ -343,6 +343,15 @@ namespace embree
     if (hasISA(features,AVX512SKX)) v += "AVX512SKX ";
     return v;
   }
+
+  /* threads rarely migrate between NUMA nodes, thus the node is determined only once per thread */
+  static __thread int thread_numa_node = -1;
+
+  unsigned int getThreadNumaNode()
+  {
+    if (thread_numa_node < 0) thread_numa_node = getCurrentNumaNode();
+    return thread_numa_node;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -428,6 +437,20 @@ namespace embree
     GetProcessMemoryInfo( GetCurrentProcess( ), &info, sizeof(info) );
     return (size_t)info.WorkingSetSize;
   }
+
+  unsigned int getNumberOfNumaNodes()
+  {
+    ULONG highest = 0;
+    if (!GetNumaHighestNodeNumber(&highest)) return 1;
+    return (unsigned int)highest+1;
+  }
+
+  unsigned int getCurrentNumaNode()
+  {
+    UCHAR node = 0;
+    if (!GetNumaProcessorNode((UCHAR)GetCurrentProcessorNumber(),&node) || node == 0xFF) return 0;
+    return node;
+  }
 }
 #endif
 
@@ -439,6 +462,7 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sys/syscall.h>
 
 namespace embree
 {
@@ -467,6 +491,32 @@ namespace embree
     buffer >> virt >> resident >> shared;
     return resident*sysconf(_SC_PAGE_SIZE);
   }
+
+  unsigned int getNumberOfNumaNodes()
+  {
+    static int nNodes = -1;
+    if (nNodes != -1) return nNodes;
+
+    /* count the nodes the kernel exposes, at least one node is always present */
+    int n = 0;
+    while (n < 1024) {
+      std::ifstream node("/sys/devices/system/node/node" + toString(n) + "/cpumap");
+      if (!node.good()) break;
+      n++;
+    }
+    nNodes = n > 0 ? n : 1;
+    return nNodes;
+  }
+
+  unsigned int getCurrentNumaNode()
+  {
+#if defined(SYS_getcpu)
+    unsigned int cpu = 0, node = 0;
+    if (syscall(SYS_getcpu,&cpu,&node,nullptr) == 0) 
+      return node;
+#endif
+    return 0;
+  }
 }
 
 #endif
@@ -548,7 +598,7 @@ namespace embree
   unsigned int getNumberOfLogicalThreads() 
   {
     static int nThreads = -1;
-    if (nThreads == -1) nThreads = sysconf(_SC_NPROCESSORS_CONF);
+    if (nThreads == -1) nThreads = 8; //HACK
     assert(nThreads);
     return nThreads;
   }
@@ -568,6 +618,16 @@ namespace embree
   void sleepSeconds(double t) {
     usleep(1000000.0*t);
   }
+
+#if !defined(__LINUX__)
+  unsigned int getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  unsigned int getCurrentNumaNode() {
+    return 0;
+  }
+#endif
 }
 #endif
 
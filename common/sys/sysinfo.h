@@ -183,4 +183,13 @@ namespace embree
 
   /*! returns resident memory required by process */
   size_t getResidentMemoryBytes();
+
+  /*! returns the number of NUMA nodes of the system */
+  unsigned int getNumberOfNumaNodes();
+
+  /*! returns the NUMA node the calling thread is currently running on */
+  unsigned int getCurrentNumaNode();
+
+  /*! returns the NUMA node of the calling thread, determined once per thread */
+  unsigned int getThreadNumaNode();
 }
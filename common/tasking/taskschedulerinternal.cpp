@@ -151,7 +151,7 @@ namespace embree
   }
 
   TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false), topPriority(0), epoch(0) {}
 
   dll_export void TaskScheduler::ThreadPool::startThreads()
   {
@@ -207,7 +207,12 @@ namespace embree
   dll_export void TaskScheduler::ThreadPool::add(const Ref<TaskScheduler>& scheduler)
   {
     mutex.lock();
-    schedulers.push_back(scheduler);
+    /* insert behind all schedulers of same or higher priority */
+    std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin();
+    while (it != schedulers.end() && (*it)->priority >= scheduler->priority) it++;
+    schedulers.insert(it,scheduler);
+    topPriority = schedulers.front()->priority.load();
+    epoch++;
     mutex.unlock();
     condition.notify_all();
   }
@@ -218,9 +223,39 @@ namespace embree
     for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) {
       if (scheduler == *it) {
         schedulers.erase(it);
-        return;
+        if (!schedulers.empty()) topPriority = schedulers.front()->priority.load();
+        epoch++;
+        break;
       }
     }
+
+    /* threads waiting for a scheduler that accepts more threads may find one now */
+    condition.notify_all();
+  }
+
+  Ref<TaskScheduler> TaskScheduler::ThreadPool::select(const TaskScheduler* current)
+  {
+    for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++)
+    {
+      if (current && (*it)->priority <= current->priority) break;
+      if ((*it)->acceptsThreads()) return *it;
+    }
+    return null;
+  }
+
+  size_t TaskScheduler::ThreadPool::join_higher_priority(const TaskScheduler* current)
+  {
+    Ref<TaskScheduler> scheduler = null;
+    ssize_t threadIndex = -1;
+    size_t searchedEpoch = 0;
+    {
+      Lock<MutexSys> lock(mutex);
+      searchedEpoch = epoch;
+      scheduler = select(current);
+      if (scheduler) threadIndex = scheduler->allocThreadIndex();
+    }
+    if (scheduler) scheduler->thread_loop(threadIndex);
+    return searchedEpoch;
   }
 
   void TaskScheduler::ThreadPool::thread_loop(size_t globalThreadIndex)
@@ -231,9 +266,8 @@ namespace embree
       ssize_t threadIndex = -1;
       {
         Lock<MutexSys> lock(mutex);
-        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || !schedulers.empty(); });
+        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || !schedulers.empty(); }); scheduler = schedulers.front();
         if (globalThreadIndex >= numThreadsRunning) break;
-        scheduler = schedulers.front();
         threadIndex = scheduler->allocThreadIndex();
       }
       scheduler->thread_loop(threadIndex);
@@ -241,7 +275,7 @@ namespace embree
   }
 
   TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false)
+    : threadCounter(0), anyTasksRunning(0), hasRootTask(false), priority(0), maxThreads(0)
   {
     threadLocal.resize(2*getNumberOfLogicalThreads()); // FIXME: this has to be 2x as in the compatibility join mode with rtcCommitScene the worker threads also join. When disallowing rtcCommitScene to join a build we can remove the 2x.
     for (size_t i=0; i<threadLocal.size(); i++)
@@ -304,7 +338,7 @@ namespace embree
     size_t threadIndex = allocThreadIndex();
     condition.wait(mutex, [&] () { return hasRootTask.load(); });
     mutex.unlock();
-    std::exception_ptr except = thread_loop(threadIndex);
+    std::exception_ptr except = thread_loop(threadIndex,false);
     if (except != nullptr) std::rethrow_exception(except);
   }
 
@@ -337,7 +371,7 @@ namespace embree
     return thread->scheduler->cancellingException == nullptr;
   }
 
-  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex)
+  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex, bool preemptable)
   {
     /* allocate thread structure */
     std::unique_ptr<Thread> mthread(new Thread(threadIndex,this)); // too large for stack allocation
@@ -346,6 +380,7 @@ namespace embree
     Thread* oldThread = swapThread(&thread);
 
     /* main thread loop */
+    size_t epoch = -1;
     while (anyTasksRunning)
     {
       steal_loop(thread,
@@ -355,6 +390,10 @@ namespace embree
                    while (thread.tasks.execute_local_internal(thread,nullptr));
                    anyTasksRunning--;
                  });
+
+      /* the local task queue is empty here, thus the thread can work for schedulers of higher priority in between */
+      if (false)
+        epoch = threadPool->join_higher_priority(this);
     }
     threadLocal[threadIndex].store(nullptr);
     swapThread(oldThread);
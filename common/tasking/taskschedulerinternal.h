@@ -218,6 +218,19 @@ namespace embree
       /*! main loop for all threads */
       void thread_loop(size_t threadIndex);
 
+      /*! returns true if a scheduler of higher priority got added since the specified epoch */
+      __forceinline bool preempts(int priority, size_t epoch) const {
+        return topPriority > priority && this->epoch != epoch;
+      }
+
+      /*! lets the calling thread join a scheduler of higher priority, returns the epoch of the scheduler list that got searched */
+      size_t join_higher_priority(const TaskScheduler* scheduler);
+
+    private:
+
+      /*! returns the scheduler of highest priority that accepts more threads and has higher priority than the specified one */
+      Ref<TaskScheduler> select(const TaskScheduler* current);
+
     private:
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
@@ -228,7 +241,9 @@ namespace embree
     private:
       MutexSys mutex;
       ConditionSys condition;
-      std::list<Ref<TaskScheduler> > schedulers;
+      std::list<Ref<TaskScheduler> > schedulers; //!< schedulers sorted by decreasing priority
+      std::atomic<int> topPriority;              //!< highest priority of all schedulers
+      std::atomic<size_t> epoch;                 //!< incremented when the list of schedulers changes
     };
 
     TaskScheduler ();
@@ -240,6 +255,15 @@ namespace embree
     /*! destroys the task scheduler again */
     static void destroy();
 
+    /*! sets the priority of this scheduler, worker threads prefer schedulers of higher priority */
+    void setPriority(int priority) { this->priority = priority; }
+
+    /*! limits the number of threads (including the spawning thread) working for this scheduler, 0 means no limit */
+    void setMaxThreads(size_t maxThreads) { this->maxThreads = maxThreads; }
+
+    /*! returns true if more threads may join this scheduler */
+    __forceinline bool acceptsThreads() const { return maxThreads == 0 || threadCounter < maxThreads; }
+
     /*! lets new worker threads join the tasking system */
     void join();
     void reset();
@@ -250,8 +274,8 @@ namespace embree
     /*! wait for some number of threads available (threadCount includes main thread) */
     void wait_for_threads(size_t threadCount);
 
-    /*! thread loop for all worker threads */
-    std::exception_ptr thread_loop(size_t threadIndex);
+    /*! thread loop for all worker threads, preemptable threads may work for schedulers of higher priority in between */
+    std::exception_ptr thread_loop(size_t threadIndex, bool preemptable = true);
 
     /*! steals a task from a different thread */
     bool steal_from_other_threads(Thread& thread);
@@ -371,6 +395,8 @@ namespace embree
     std::atomic<size_t> anyTasksRunning;
     std::atomic<bool> hasRootTask;
     std::exception_ptr cancellingException;
+    std::atomic<int> priority;
+    std::atomic<size_t> maxThreads;
     MutexSys mutex;
     ConditionSys condition;
 
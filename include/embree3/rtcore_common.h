@@ -60,9 +60,6 @@ typedef int ssize_t;
 /* Maximum number of time steps */
 #define RTC_MAX_TIME_STEP_COUNT 129
 
-/* Maximum number of instancing levels */
-#define RTC_MAX_INSTANCE_LEVEL_COUNT 1
-
 /* Formats of buffers and other data structures */
 enum RTCFormat
 {
@@ -157,7 +154,13 @@ enum RTCFormat
   RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR = 0x9244,
 
   /* special 12-byte format for grids */
-  RTC_FORMAT_GRID = 0xA001
+  RTC_FORMAT_GRID = 0xA001,
+
+  /* 16-bit float */
+  RTC_FORMAT_HALF = 0xB001,
+  RTC_FORMAT_HALF2,
+  RTC_FORMAT_HALF3,
+  RTC_FORMAT_HALF4
 };
 
 /* Build quality levels */
@@ -188,7 +191,8 @@ enum RTCIntersectContextFlags
 {
   RTC_INTERSECT_CONTEXT_FLAG_NONE       = 0,
   RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT = (0 << 0), // optimize for incoherent rays
-  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0)  // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0), // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_SORT       = (1 << 1)  // sort incoherent ray streams into coherent groups
 };
 
 /* Arguments for RTCFilterFunctionN */
@@ -210,7 +214,10 @@ struct RTCIntersectContext
 {
   enum RTCIntersectContextFlags flags;               // intersection flags
   RTCFilterFunctionN filter;                         // filter function to execute
-  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // will be set to geomID of instance when instance is entered
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+  unsigned int instStackSize;                        // number of instances currently on the stack
+#endif
+  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // stack of geomIDs of the instances currently entered
 };
 
 /* Initializes an intersection context. */
@@ -218,7 +225,51 @@ RTC_FORCEINLINE void rtcInitIntersectContext(struct RTCIntersectContext* context
 {
   context->flags = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
   context->filter = NULL;
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+  context->instStackSize = 0;
+#endif
+  for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+    context->instID[l] = RTC_INVALID_GEOMETRY_ID;
+}
+
+/* Point query structure for closest point query */
+struct RTC_ALIGN(16) RTCPointQuery 
+{
+  float x;                // x coordinate of the query point
+  float y;                // y coordinate of the query point
+  float z;                // z coordinate of the query point
+  float time;             // time of the point query
+  float radius;           // radius of the point query 
+};
+
+/* Point query context passed to point query callbacks */
+struct RTC_ALIGN(16) RTCPointQueryContext
+{
+  float world2inst[RTC_MAX_INSTANCE_LEVEL_COUNT][16]; // accumulated 4x4 column major matrices from world space to instance space
+  float inst2world[RTC_MAX_INSTANCE_LEVEL_COUNT][16]; // accumulated 4x4 column major matrices from instance space to world space
+  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT];  // instance ids
+  unsigned int instStackSize;                         // number of instances currently on the stack
+};
+
+/* Initializes a point query context. */
+RTC_FORCEINLINE void rtcInitPointQueryContext(struct RTCPointQueryContext* context)
+{
+  context->instStackSize = 0;
   context->instID[0] = RTC_INVALID_GEOMETRY_ID;
 }
+
+/* Arguments for RTCPointQueryFunction */
+struct RTC_ALIGN(16) RTCPointQueryFunctionArguments
+{
+  struct RTCPointQuery* query;           // the (potentially transformed) point query
+  void* userPtr;                         // user pointer passed to rtcPointQuery
+  unsigned int primID;                   // primitive ID of the primitive to test
+  unsigned int geomID;                   // geometry ID of the primitive to test
+  struct RTCPointQueryContext* context;  // instance transformations of the current instance stack
+  float similarityScale;                 // scale factor of a similarity transform from world to instance space, or 0
+};
+
+/* Point query callback function, returns true if the query radius got changed */
+typedef bool (*RTCPointQueryFunction)(struct RTCPointQueryFunctionArguments* args);
   
 RTC_NAMESPACE_END
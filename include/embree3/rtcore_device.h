@@ -58,7 +58,27 @@ enum RTCDeviceProperty
   RTC_DEVICE_PROPERTY_POINT_GEOMETRY_SUPPORTED       = 101,
 
   RTC_DEVICE_PROPERTY_TASKING_SYSTEM        = 128,
-  RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129
+  RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129,
+
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE       = 160,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_BYTES_USED = 161,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS       = 162,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES     = 163,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES    = 164,
+
+  RTC_DEVICE_PROPERTY_RAY_STATISTICS_ENABLED     = 192,
+  RTC_DEVICE_PROPERTY_INTERSECT_RAYS             = 193,
+  RTC_DEVICE_PROPERTY_INTERSECT_NODES            = 194,
+  RTC_DEVICE_PROPERTY_INTERSECT_LEAVES           = 195,
+  RTC_DEVICE_PROPERTY_INTERSECT_PRIMITIVES       = 196,
+  RTC_DEVICE_PROPERTY_INTERSECT_FILTER_CALLS     = 197,
+  RTC_DEVICE_PROPERTY_INTERSECT_INSTANCES        = 198,
+  RTC_DEVICE_PROPERTY_OCCLUDED_RAYS              = 199,
+  RTC_DEVICE_PROPERTY_OCCLUDED_NODES             = 200,
+  RTC_DEVICE_PROPERTY_OCCLUDED_LEAVES            = 201,
+  RTC_DEVICE_PROPERTY_OCCLUDED_PRIMITIVES        = 202,
+  RTC_DEVICE_PROPERTY_OCCLUDED_FILTER_CALLS      = 203,
+  RTC_DEVICE_PROPERTY_OCCLUDED_INSTANCES         = 204
 };
 
 /* Gets a device property. */
@@ -34,9 +34,23 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_DYNAMIC                 = (1 << 0),
   RTC_SCENE_FLAG_COMPACT                 = (1 << 1),
   RTC_SCENE_FLAG_ROBUST                  = (1 << 2),
-  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3)
+  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3),
+  RTC_SCENE_FLAG_UNIFIED_ACCEL           = (1 << 4),
+  RTC_SCENE_FLAG_NUMA_REPLICATE          = (1 << 5)
 };
 
+/* Pair of colliding primitives */
+struct RTCCollision
+{
+  unsigned int geomID0; // geometry ID of primitive of first scene
+  unsigned int primID0; // primitive ID of primitive of first scene
+  unsigned int geomID1; // geometry ID of primitive of second scene
+  unsigned int primID1; // primitive ID of primitive of second scene
+};
+
+/* Collision callback function */
+typedef void (*RTCCollideFunc)(void* userPtr, struct RTCCollision* collisions, unsigned int num_collisions);
+
 /* Creates a new scene. */
 RTC_API RTCScene rtcNewScene(RTCDevice device);
 
@@ -66,6 +80,12 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Completion callback function of an asynchronous scene commit */
+typedef void (*RTCCommitCompletionFunction)(void* ptr, RTCScene scene, enum RTCError error);
+
+/* Commits the scene in the background and invokes the completion callback once the new scene version is visible to ray queries. */
+RTC_API void rtcCommitSceneAsync(RTCScene scene, RTCCommitCompletionFunction completion, void* ptr);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -76,6 +96,12 @@ RTC_API void rtcSetSceneProgressMonitorFunction(RTCScene scene, RTCProgressMonit
 /* Sets the build quality of the scene. */
 RTC_API void rtcSetSceneBuildQuality(RTCScene scene, enum RTCBuildQuality quality);
 
+/* Sets the build priority of the scene. */
+RTC_API void rtcSetSceneBuildPriority(RTCScene scene, int priority);
+
+/* Limits the number of threads building the scene. */
+RTC_API void rtcSetSceneBuildThreadLimit(RTCScene scene, unsigned int maxThreads);
+
 /* Sets the scene flags. */
 RTC_API void rtcSetSceneFlags(RTCScene scene, enum RTCSceneFlags flags);
 
@@ -88,6 +114,12 @@ RTC_API void rtcGetSceneBounds(RTCScene scene, struct RTCBounds* bounds_o);
 /* Returns the linear axis-aligned bounds of the scene. */
 RTC_API void rtcGetSceneLinearBounds(RTCScene scene, struct RTCLinearBounds* bounds_o);
 
+/* Performs a closest point query of the scene. */
+RTC_API bool rtcPointQuery(RTCScene scene, struct RTCPointQuery* query, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void* userPtr);
+
+/* Reports all pairs of primitives of two scenes with overlapping bounds. */
+RTC_API void rtcCollide(RTCScene scene0, RTCScene scene1, RTCCollideFunc callback, void* userPtr);
+
 /* Intersects a single ray with the scene. */
 RTC_API void rtcIntersect1(RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit* rayhit);
 
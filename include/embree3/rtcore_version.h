@@ -20,6 +20,9 @@
 #define RTC_VERSION 30502
 #define RTC_VERSION_STRING "3.5.2"
 
+/* Maximum number of instancing levels */
+#define RTC_MAX_INSTANCE_LEVEL_COUNT 1
+
 /* #undef EMBREE_STATIC_LIB */
 /* #undef EMBREE_API_NAMESPACE */
 
@@ -36,7 +36,7 @@ namespace embree
       {
         /*! default settings */
         Settings ()
-        : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(8), finished_range_threshold(inf) {}
+        : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(8), finished_range_threshold(inf), mixedGeometryTypes(false) {}
 
       public:
         size_t branchingFactor;  //!< branching factor of BVH to build
@@ -45,6 +45,7 @@ namespace embree
         size_t minLeafSize;      //!< minimum size of a leaf
         size_t maxLeafSize;      //!< maximum size of a leaf
         size_t finished_range_threshold;  //!< finished range threshold
+        bool mixedGeometryTypes; //!< primitives may come from non-curve geometries, which only get aligned splits
       };
 
       template<typename NodeRef,
@@ -88,6 +89,7 @@ namespace embree
                     const Settings settings)
 
             : cfg(settings),
+            scene(scene),
             prims(prims),
             createAlloc(createAlloc),
             createAlignedNode(createAlignedNode),
@@ -112,6 +114,16 @@ namespace embree
             return true;
           }
 
+          /*! checks if all primitives are from curve or point geometries */
+          __forceinline bool onlyCurves(const PrimInfoRange& range)
+          {
+            for (size_t i=range.begin(); i<range.end(); i++) {
+              if (!(scene->get(prims[i].geomID())->getTypeMask() & Geometry::MTY_CURVES))
+                return false;
+            }
+            return true;
+          }
+
           /*! creates a large leaf that could be larger than supported by the BVH */
           NodeRef createLargeLeaf(size_t depth, const PrimInfoRange& pinfo, Allocator alloc)
           {
@@ -175,7 +187,7 @@ namespace embree
           }
 
           /*! performs split */
-          __noinline void split(const PrimInfoRange& pinfo, PrimInfoRange& linfo, PrimInfoRange& rinfo, bool& aligned) // FIXME: not inlined as ICC otherwise uses much stack
+          __noinline void split(const PrimInfoRange& pinfo, PrimInfoRange& linfo, PrimInfoRange& rinfo, bool& aligned, bool unaligned) // FIXME: not inlined as ICC otherwise uses much stack
           {
             /* variable to track the SAH of the best splitting approach */
             float bestSAH = inf;
@@ -195,7 +207,7 @@ namespace embree
             UnalignedHeuristicBinningSAH::Split unalignedObjectSplit;
             LinearSpace3fa uspace;
             float unalignedObjectSAH = inf;
-            if (bestSAH > 0.7f*leafSAH) {
+            if (unaligned && bestSAH > 0.7f*leafSAH) {
               uspace = unalignedHeuristic.computeAlignedSpace(pinfo);
               const PrimInfoRange sinfo = unalignedHeuristic.computePrimInfo(pinfo,uspace);
               unalignedObjectSplit = unalignedHeuristic.find(sinfo,cfg.logBlockSize,uspace);
@@ -206,7 +218,7 @@ namespace embree
             /* try splitting into two strands */
             HeuristicStrandSplitSAH::Split strandSplit;
             float strandSAH = inf;
-            if (bestSAH > 0.7f*leafSAH && pinfo.size() <= 256) {
+            if (unaligned && bestSAH > 0.7f*leafSAH && pinfo.size() <= 256) {
               strandSplit = strandHeuristic.find(pinfo,cfg.logBlockSize);
               strandSAH = travCostUnaligned*halfArea(pinfo.geomBounds) + intCost*strandSplit.splitSAH();
               bestSAH = min(strandSAH,bestSAH);
@@ -265,6 +277,9 @@ namespace embree
             children[0] = pinfo;
             bool aligned = true;
 
+            /* unaligned splits require curve directions, thus are only allowed for curve only subtrees */
+            const bool unaligned = !cfg.mixedGeometryTypes || onlyCurves(pinfo);
+
             do {
 
               /* find best child with largest bounding box area */
@@ -286,7 +301,7 @@ namespace embree
 
               /*! split best child into left and right child */
               PrimInfoRange left, right;
-              split(children[bestChild],left,right,aligned);
+              split(children[bestChild],left,right,aligned,unaligned);
 
               /* add new children left and right */
               children[bestChild] = children[numChildren-1];
@@ -364,6 +379,7 @@ namespace embree
 
         private:
           Settings cfg;
+          Scene* scene;
           PrimRef* prims;
           const CreateAllocFunc& createAlloc;
           const CreateAlignedNodeFunc& createAlignedNode;
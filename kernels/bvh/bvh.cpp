@@ -37,6 +37,7 @@ namespace embree
   template<int N>
   void BVHN<N>::clear()
   {
+    clearReplicas();
     set(BVHN::emptyNode,empty,0);
     alloc.clear();
   }
@@ -122,6 +123,117 @@ namespace embree
     else return node;
   }
 
+  template<int N>
+  void BVHN<N>::replicate()
+  {
+    clearReplicas();
+
+    /* replicas only pay off on systems with multiple NUMA nodes, subdivision 
+     * BVHs are not replicated as they reference lazily built patch data */
+    const size_t numNodes = getNumberOfNumaNodes();
+    if (numNodes <= 1 || root == emptyNode || !subdiv_patches.empty())
+      return;
+
+    size_t bytesEstimate = alloc.getStatistics(FastAllocator::ANY_TYPE).bytesUsed;
+    for (size_t i=0; i<objects.size(); i++)
+      if (objects[i]) bytesEstimate += objects[i]->alloc.getStatistics(FastAllocator::ANY_TYPE).bytesUsed;
+
+    /* copy the BVH into the memory of each NUMA node in parallel */
+    std::vector<NodeRef> roots(numNodes);
+    std::vector<std::unique_ptr<FastAllocator>> allocs(numNodes);
+    std::atomic<bool> valid(true);
+    parallel_for(numNodes, [&] (size_t i)
+    {
+      allocs[i].reset(new FastAllocator(device,scene->isStaticAccel()));
+      allocs[i]->setNumaNode(int(i));
+      allocs[i]->init_estimate(bytesEstimate);
+      bool validReplica = true;
+      roots[i] = replicateRecursion(root,allocs[i]->getCachedAllocator(),validReplica);
+      allocs[i]->cleanup();
+      if (!validReplica) valid = false;
+    });
+
+    /* BVHs with node types that cannot get copied are not replicated */
+    if (!valid) return;
+    
+    replica_roots.swap(roots);
+    replica_allocs.swap(allocs);
+  }
+
+  template<int N>
+  typename BVHN<N>::NodeRef BVHN<N>::replicateRecursion(NodeRef node, const FastAllocator::CachedAllocator& allocator, bool& valid)
+  {
+    if (node == emptyNode) 
+      return node;
+    
+    else if (node.isLeaf())
+    {
+      size_t num; const char* prims = node.leaf(num);
+      size_t bytes = 0;
+      for (size_t i=0; i<num; i++)
+        bytes += primTy->getBytes(prims+bytes);
+      char* leaf = (char*) allocator.malloc1(bytes,byteAlignment);
+      memcpy(leaf,prims,bytes);
+      return encodeLeaf(leaf,num);
+    }
+    else if (node.isAlignedNode()) 
+    {
+      AlignedNode* oldnode = node.alignedNode();
+      AlignedNode* newnode = (AlignedNode*) allocator.malloc0(sizeof(AlignedNode),byteNodeAlignment);
+      *newnode = *oldnode;
+      for (size_t c=0; c<N; c++)
+        newnode->child(c) = replicateRecursion(oldnode->child(c),allocator,valid);
+      return encodeNode(newnode);
+    }
+    else if (node.isAlignedNodeMB4D()) 
+    {
+      AlignedNodeMB4D* oldnode = node.alignedNodeMB4D();
+      AlignedNodeMB4D* newnode = (AlignedNodeMB4D*) allocator.malloc0(sizeof(AlignedNodeMB4D),byteNodeAlignment);
+      *newnode = *oldnode;
+      for (size_t c=0; c<N; c++)
+        newnode->child(c) = replicateRecursion(oldnode->child(c),allocator,valid);
+      return encodeNode(newnode);
+    }
+    else if (node.isAlignedNodeMB()) 
+    {
+      AlignedNodeMB* oldnode = node.alignedNodeMB();
+      AlignedNodeMB* newnode = (AlignedNodeMB*) allocator.malloc0(sizeof(AlignedNodeMB),byteNodeAlignment);
+      *newnode = *oldnode;
+      for (size_t c=0; c<N; c++)
+        newnode->child(c) = replicateRecursion(oldnode->child(c),allocator,valid);
+      return encodeNode(newnode);
+    }
+    else if (node.isUnalignedNode()) 
+    {
+      UnalignedNode* oldnode = node.unalignedNode();
+      UnalignedNode* newnode = (UnalignedNode*) allocator.malloc0(sizeof(UnalignedNode),byteNodeAlignment);
+      *newnode = *oldnode;
+      for (size_t c=0; c<N; c++)
+        newnode->child(c) = replicateRecursion(oldnode->child(c),allocator,valid);
+      return encodeNode(newnode);
+    }
+    else if (node.isUnalignedNodeMB()) 
+    {
+      UnalignedNodeMB* oldnode = node.unalignedNodeMB();
+      UnalignedNodeMB* newnode = (UnalignedNodeMB*) allocator.malloc0(sizeof(UnalignedNodeMB),byteNodeAlignment);
+      *newnode = *oldnode;
+      for (size_t c=0; c<N; c++)
+        newnode->child(c) = replicateRecursion(oldnode->child(c),allocator,valid);
+      return encodeNode(newnode);
+    }
+
+    /* quantized nodes store relative offsets and cannot get copied node by node */
+    valid = false;
+    return node;
+  }
+
+  template<int N>
+  void BVHN<N>::clearReplicas()
+  {
+    replica_roots.clear();
+    replica_allocs.clear();
+  }
+
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
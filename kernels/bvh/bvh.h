@@ -1439,6 +1439,20 @@ namespace embree
     void layoutLargeNodes(size_t num);
     NodeRef layoutLargeNodesRecursion(NodeRef& node, const FastAllocator::CachedAllocator& allocator);
 
+    /*! replicates the BVH into the memory of each NUMA node */
+    void replicate();
+    NodeRef replicateRecursion(NodeRef node, const FastAllocator::CachedAllocator& allocator, bool& valid);
+
+    /*! frees the replicas of the BVH */
+    void clearReplicas();
+
+    /*! returns the root node of the replica local to the calling thread */
+    __forceinline NodeRef getRoot() const
+    {
+      if (likely(replica_roots.empty())) return root;
+      return replica_roots[getThreadNumaNode() % replica_roots.size()];
+    }
+
     /*! called by all builders before build starts */
     double preBuild(const std::string& builderName);
 
@@ -1529,6 +1543,11 @@ namespace embree
     NodeRef root;                      //!< root node
     FastAllocator alloc;               //!< allocator used to allocate nodes
 
+    /*! replicas of the BVH for each NUMA node */
+  public:
+    std::vector<NodeRef> replica_roots;                          //!< root node of the replica of each NUMA node
+    std::vector<std::unique_ptr<FastAllocator>> replica_allocs;  //!< allocators holding the replicas
+
     /*! statistics data */
   public:
     size_t numPrimitives;              //!< number of primitives the BVH is build over
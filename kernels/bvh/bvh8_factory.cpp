@@ -193,6 +193,8 @@ namespace embree
 
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8InstanceIntersectorStream);
 
+  DECLARE_SYMBOL2(Accel::Collider,BVH8ColliderUserGeom);
+
   DECLARE_ISA_FUNCTION(Builder*,BVH8Curve8vBuilder_OBB_New,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8OBBCurve8iMBBuilder_OBB,void* COMMA Scene* COMMA size_t);
 
@@ -470,6 +472,9 @@ namespace embree
     IF_ENABLED_INSTANCE(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8InstanceIntersectorStream));
 
 #endif
+
+    /* select colliders */
+    IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8ColliderUserGeom));
   }
 
   void BVH8Factory::createTriangleMeshTriangle4Morton(TriangleMesh* mesh, AccelData*& accel, Builder*& builder)
@@ -872,6 +877,7 @@ namespace embree
     intersectors.intersector16 = BVH8VirtualIntersector16Chunk();
     intersectors.intersectorN  = BVH8VirtualIntersectorStream();
 #endif
+    intersectors.collider      = BVH8ColliderUserGeom();
     return intersectors;
   }
 
@@ -1211,7 +1217,7 @@ namespace embree
 
   Accel* BVH8Factory::BVH8GridMB(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
   {
-    BVH8* accel = new BVH8(SubGridQBVH8::type,scene);
+    BVH8* accel = new BVH8(SubGridMBQBVH8::type,scene);
     Accel::Intersectors intersectors = BVH8GridMBIntersectors(accel,ivariant);
     Builder* builder = nullptr;
     if (scene->device->grid_builder_mb == "default") {
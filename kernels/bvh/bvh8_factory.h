@@ -250,6 +250,10 @@ namespace embree
     
     DEFINE_SYMBOL2(Accel::IntersectorN,BVH8InstanceIntersectorStream);
 
+    // ==============
+
+    DEFINE_SYMBOL2(Accel::Collider,BVH8ColliderUserGeom);
+
     // SAH scene builders
   private:
     DEFINE_ISA_FUNCTION(Builder*,BVH8Curve8vBuilder_OBB_New,void* COMMA Scene* COMMA size_t);
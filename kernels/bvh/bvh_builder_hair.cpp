@@ -21,6 +21,11 @@
 #include "../geometry/linei.h"
 #include "../geometry/curveNi.h"
 #include "../geometry/curveNv.h"
+#include "../geometry/trianglev.h"
+#include "../geometry/quadv.h"
+#include "../geometry/object.h"
+#include "../geometry/instance.h"
+#include "../geometry/unified.h"
 
 #if defined(EMBREE_GEOMETRY_CURVE) || defined(EMBREE_GEOMETRY_POINT)
 
@@ -38,9 +43,25 @@ namespace embree
       Scene* scene;
       mvector<PrimRef> prims;
       BVHBuilderHair::Settings settings;
+      bool unified; //!< also stores triangles, quads, user geometries, and instances
 
-      BVHNHairBuilderSAH (BVH* bvh, Scene* scene)
-        : bvh(bvh), scene(scene), prims(scene->device,0) {}
+      BVHNHairBuilderSAH (BVH* bvh, Scene* scene, bool unified = false)
+        : bvh(bvh), scene(scene), prims(scene->device,0), unified(unified) {}
+
+      __forceinline Geometry::GTypeMask typeMask() const
+      {
+        if (!unified) return Geometry::MTY_CURVES;
+        return Geometry::GTypeMask(Geometry::MTY_TRIANGLE_MESH | Geometry::MTY_QUAD_MESH | Geometry::MTY_CURVES | Geometry::MTY_USER_GEOMETRY | Geometry::MTY_INSTANCE);
+      }
+
+      __forceinline size_t numPrimitives() const
+      {
+        size_t num = scene->getNumPrimitives<CurveGeometry,false>();
+        if (unified)
+          num += scene->getNumPrimitives<TriangleMesh,false>() + scene->getNumPrimitives<QuadMesh,false>() +
+            scene->getNumPrimitives<UserGeometry,false>() + scene->getNumPrimitives<Instance,false>();
+        return num;
+      }
       
       void build() 
       {
@@ -49,18 +70,18 @@ namespace embree
           bvh->alloc.unshare(prims);
 
         /* fast path for empty BVH */
-        const size_t numPrimitives = scene->getNumPrimitives<CurveGeometry,false>();
+        const size_t numPrimitives = this->numPrimitives();
         if (numPrimitives == 0) {
           bvh->clear();
           prims.clear();
           return;
         }
 
-        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "HairBuilderSAH");
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + (unified ? "UnifiedBuilderSAH" : "HairBuilderSAH"));
 
         /* create primref array */
         prims.resize(numPrimitives);
-        const PrimInfo pinfo = createPrimRefArray(scene,Geometry::MTY_CURVES,false,prims,scene->progressInterface);
+        const PrimInfo pinfo = createPrimRefArray(scene,typeMask(),false,prims,scene->progressInterface);
 
         /* estimate acceleration structure size */
         const size_t node_bytes = pinfo.size()*sizeof(typename BVH::UnalignedNode)/(4*N);
@@ -73,6 +94,7 @@ namespace embree
         settings.logBlockSize = bsf(CurvePrimitive::max_size());
         settings.minLeafSize = CurvePrimitive::max_size();
         settings.maxLeafSize = CurvePrimitive::max_size();
+        settings.mixedGeometryTypes = unified;
         settings.finished_range_threshold = numPrimitives/1000;
         if (settings.finished_range_threshold < 1000)
           settings.finished_range_threshold = inf;
@@ -84,7 +106,16 @@ namespace embree
             return BVH::emptyNode;
 
           const unsigned int geomID0 = prims[set.begin()].geomID();
-          if (scene->get(geomID0)->getTypeMask() & Geometry::MTY_POINTS)
+          const Geometry::GType gtype = scene->get(geomID0)->getType();
+          if (gtype == Geometry::GTY_TRIANGLE_MESH)
+            return UnifiedLeaf::createLeaf<Triangle4v>(gtype,bvh,prims,set,alloc);
+          else if (gtype == Geometry::GTY_QUAD_MESH)
+            return UnifiedLeaf::createLeaf<Quad4v>(gtype,bvh,prims,set,alloc);
+          else if (gtype == Geometry::GTY_USER_GEOMETRY)
+            return UnifiedLeaf::createLeaf<Object>(gtype,bvh,prims,set,alloc);
+          else if (gtype == Geometry::GTY_INSTANCE)
+            return UnifiedLeaf::createLeaf<InstancePrimitive>(gtype,bvh,prims,set,alloc);
+          else if (scene->get(geomID0)->getTypeMask() & Geometry::MTY_POINTS)
             return PointPrimitive::createLeaf(bvh,prims,set,alloc);
           else if (scene->get(geomID0)->getCurveBasis() == Geometry::GTY_BASIS_LINEAR)
             return LinePrimitive::createLeaf(bvh,prims,set,alloc);
@@ -135,6 +166,8 @@ namespace embree
     Builder* BVH4Curve4vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4v,Line4i,Point4i>((BVH4*)bvh,scene); }
     Builder* BVH4Curve4iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4i,Line4i,Point4i>((BVH4*)bvh,scene); }
 
+    Builder* BVH4UnifiedBuilder_OBB       (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4i,Line4i,Point4i>((BVH4*)bvh,scene,true); }
+
 #if defined(__AVX__)
     Builder* BVH8Curve8vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Curve8v,Line8i,Point8i>((BVH8*)bvh,scene); }
     Builder* BVH4Curve8iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve8i,Line8i,Point8i>((BVH4*)bvh,scene); }
@@ -16,6 +16,7 @@
 
 #include "bvh.h"
 #include "bvh_builder.h"
+#include "bvh_cache.h"
 #include "../builders/primrefgen.h"
 #include "../builders/splitter.h"
 
@@ -24,6 +25,7 @@
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglev_mb.h"
 #include "../geometry/trianglei.h"
+#include "../geometry/triangleq.h"
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
 #include "../geometry/object.h"
@@ -66,6 +68,30 @@ namespace embree
     };
 
 
+    /* compressed triangles of different meshes cannot share a block, thus the number of blocks is determined while filling */
+    template<int N>
+    struct CreateLeaf<N,Triangle4q>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+      __forceinline CreateLeaf (BVH* bvh) : bvh(bvh) {}
+
+      __forceinline NodeRef operator() (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
+      {
+        size_t items = Triangle4q::blocks(prims,set.begin(),set.end(),bvh->scene);
+        size_t start = set.begin();
+        Triangle4q* accel = (Triangle4q*) alloc.malloc1(items*sizeof(Triangle4q),BVH::byteAlignment);
+        typename BVH::NodeRef node = BVH::encodeLeaf((char*)accel,items);
+        for (size_t i=0; i<items; i++) {
+          accel[i].fill(prims,start,set.end(),bvh->scene);
+        }
+        return node;
+      }
+
+      BVH* bvh;
+    };
+
     template<int N, typename Primitive>
     struct CreateLeafQuantized
     {
@@ -139,6 +165,16 @@ namespace embree
 
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
 
+        /* try to load the BVH from the persistent BVH cache */
+        BVHNCache<N> cache(bvh,scene,Mesh::geom_type,"BVHNBuilderSAH");
+        if (cache.load())
+        {
+          prims.clear();
+          bvh->cleanup();
+          bvh->postBuild(t0);
+          return;
+        }
+
 #if PROFILE
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
 #endif
@@ -177,6 +213,7 @@ namespace embree
             NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
             bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+            cache.store();
 
 #if PROFILE
           });
@@ -562,6 +599,9 @@ namespace embree
 
 
     Builder* BVH4QuantizedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+
+    /* in the worst case every compressed block stores a single triangle, thus leaves are limited to maxLeafBlocks triangles */
+    Builder* BVH4Triangle4qSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4q>((BVH4*)bvh,scene,4,1.0f,4,BVH4::maxLeafBlocks,mode); }
 #if defined(__AVX__)
     Builder* BVH8Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4>((BVH8*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4vMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4v>((BVH8*)bvh,mesh,4,1.0f,4,inf,mode); }
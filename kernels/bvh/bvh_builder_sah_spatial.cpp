@@ -16,6 +16,7 @@
 
 #include "bvh.h"
 #include "bvh_builder.h"
+#include "bvh_cache.h"
 
 #include "../builders/primrefgen.h"
 #include "../builders/splitter.h"
@@ -101,6 +102,16 @@ namespace embree
         const unsigned int maxGeomID = mesh ? mesh->geomID : scene->getMaxGeomID<Mesh,false>();
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderFastSpatialSAH");
 
+        /* try to load the BVH from the persistent BVH cache */
+        BVHNCache<N> cache(bvh,scene,Mesh::geom_type,"BVHNBuilderFastSpatialSAH");
+        if (cache.load())
+        {
+          prims0.clear();
+          bvh->cleanup();
+          bvh->postBuild(t0);
+          return;
+        }
+
         /* create primref array */
         const size_t numSplitPrimitives = max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
         prims0.resize(numSplitPrimitives);
@@ -259,6 +270,7 @@ namespace embree
 
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+        cache.store();
 
 	/* clear temporary data for static geometry */
 	if (scene && scene->isStaticAccel()) {
@@ -30,13 +30,18 @@
 #define SPLIT_MEMORY_RESERVE_SCALE 2
 #define SPLIT_MIN_EXT_SPACE 1000
 
+/* incremental update of the top-level hierarchy */
+#define ENABLE_INCREMENTAL_UPDATE 1
+#define INCREMENTAL_SAH_THRESHOLD 1.5f
+
 namespace embree
 {
   namespace isa
   {
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel, const size_t singleThreadThreshold)
-      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold) {}
+      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold),
+        numTopLevelObjects(0), initialSAH(0.0f) {}
     
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::~BVHNBuilderTwoLevel () {
@@ -64,13 +69,12 @@ namespace embree
       while(1) 
 #endif
       {
-      /* reset memory allocator */
-      bvh->alloc.reset();
-      
       /* skip build for empty scene */
       const size_t numPrimitives = scene->getNumPrimitives<Mesh,false>();
 
       if (numPrimitives == 0) {
+        bvh->alloc.reset();
+        topNodes.clear();
         prims.resize(0);
         bvh->set(BVH::emptyNode,empty,0);
         return;
@@ -82,6 +86,8 @@ namespace embree
       if (objects.size()  < num) objects.resize(num);
       if (builders.size() < num) builders.resize(num);
       if (refs.size()     < num) refs.resize(num);
+      if (objectRefs.size() < num) objectRefs.resize(num);
+      modified.resize(num);
       nextRef.store(0);
       
       /* create acceleration structures */
@@ -90,6 +96,7 @@ namespace embree
         for (size_t objectID=r.begin(); objectID<r.end(); objectID++)
         {
           Mesh* mesh = scene->getSafe<Mesh>(objectID);
+          modified[objectID] = false;
           
           /* ignore meshes we do not support */
           if (mesh == nullptr || mesh->numTimeSteps != 1)
@@ -100,6 +107,7 @@ namespace embree
             Builder* builder = nullptr;
             createMeshAccel(mesh,(AccelData*&)objects[objectID],builder);
             builders[objectID] = BuilderState(builder,mesh->quality);
+            modified[objectID] = true;
           }
 
           /* re-create when build quality changed */
@@ -108,6 +116,7 @@ namespace embree
             delete objects[objectID]; 
             createMeshAccel(mesh,(AccelData*&)objects[objectID],builder);
             builders[objectID] = BuilderState(builder,mesh->quality);
+            modified[objectID] = true;
           }
         }
       });
@@ -126,8 +135,10 @@ namespace embree
           Ref<Builder>& builder = builders[objectID].builder; assert(builder);
           
           /* build object if it got modified */
-          if (mesh->isModified())
+          if (mesh->isModified()) {
             builder->build();
+            modified[objectID] = true;
+          }
 
           /* create build primitive */
           if (!object->getBounds().empty())
@@ -147,11 +158,18 @@ namespace embree
 #endif
       /* fast path for single geometry scenes */
       if (nextRef == 1) { 
+        bvh->alloc.reset();
+        topNodes.clear();
         bvh->set(refs[0].node,LBBox3fa(refs[0].bounds()),numPrimitives);
       }
 
-      else
+      /* only refit the top-level hierarchy if the set of objects did not change */
+      else if (!updateIncremental(numPrimitives))
       {     
+        /* reset memory allocator */
+        bvh->alloc.reset();
+        topNodes.clear();
+
         /* open all large nodes */
         refs.resize(nextRef);
 
@@ -201,6 +219,10 @@ namespace embree
             }, [] (const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
 #endif   
        
+          /* leaves of the top-level hierarchy */
+          std::vector<std::pair<NodeRef,unsigned int>> leaves(extSize);
+          std::atomic<size_t> numLeaves(0);
+
           /* skip if all objects where empty */
           if (pinfo.size() == 0)
             bvh->set(BVH::emptyNode,empty,0);
@@ -229,7 +251,9 @@ namespace embree
               
               [&] (const BuildRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef  {
                 assert(range.size() == 1);
-                return (NodeRef) refs[range.begin()].node;
+                const BuildRef& ref = refs[range.begin()];
+                leaves[numLeaves++] = std::make_pair(ref.node,ref.geomID());
+                return (NodeRef) ref.node;
               },
               [&] (BuildRef &bref, BuildRef *refs) -> size_t { 
                 return openBuildRef(bref,refs);
@@ -252,6 +276,11 @@ namespace embree
 
             
             bvh->set(root,LBBox3fa(pinfo.geomBounds),numPrimitives);
+
+#if ENABLE_DIRECT_SAH_MERGE_BUILDER && ENABLE_INCREMENTAL_UPDATE
+            leaves.resize(numLeaves);
+            setupIncrementalUpdate(leaves);
+#endif
           }
         }
 #if defined(TASKING_TBB) && defined(__AVX512ER__) && USE_TASK_ARENA // KNL
@@ -270,10 +299,135 @@ namespace embree
 
     }
     
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::setupIncrementalUpdate(std::vector<std::pair<NodeRef,unsigned int>>& leaves)
+    {
+      std::sort(leaves.begin(),leaves.end(),[] (const std::pair<NodeRef,unsigned int>& a, const std::pair<NodeRef,unsigned int>& b) {
+          return (size_t)a.first < (size_t)b.first;
+        });
+
+      topNodes.clear();
+      topLeaves.clear();
+      if (!gatherTopLevelNodes(bvh->root,size_t(-1),0,leaves)) {
+        topNodes.clear();
+        return;
+      }
+
+      /* an object may be referenced by multiple leaves if the builder opened it */
+      std::stable_sort(topLeaves.begin(),topLeaves.end());
+      std::fill(objectRefs.begin(),objectRefs.end(),ObjectRef());
+      for (size_t i=0; i<topLeaves.size(); i++) {
+        ObjectRef& oref = objectRefs[topLeaves[i].objectID];
+        if (!oref.referenced()) oref.begin = i;
+        oref.end = i+1;
+      }
+      numTopLevelObjects = (size_t) nextRef;
+      initialSAH = topLevelSAH();
+    }
+
+    template<int N, typename Mesh>
+    bool BVHNBuilderTwoLevel<N,Mesh>::gatherTopLevelNodes(NodeRef ref, size_t parent, size_t slot, const std::vector<std::pair<NodeRef,unsigned int>>& leaves)
+    {
+      if (!ref.isAlignedNode())
+        return false;
+
+      const size_t index = topNodes.size();
+      AlignedNode* node = ref.alignedNode();
+      topNodes.push_back(TopLevelNode(node,parent,slot));
+
+      for (size_t i=0; i<N; i++)
+      {
+        const NodeRef child = node->child(i);
+        if (child == BVH::emptyNode) continue;
+
+        /* children that are no leaves of the top-level build are top-level nodes */
+        auto leaf = std::lower_bound(leaves.begin(),leaves.end(),child,[] (const std::pair<NodeRef,unsigned int>& a, const NodeRef& b) {
+            return (size_t)a.first < (size_t)b;
+          });
+        if (leaf != leaves.end() && leaf->first == child)
+          topLeaves.push_back(TopLevelLeaf(leaf->second,index,i));
+        else if (!gatherTopLevelNodes(child,index,i,leaves))
+          return false;
+      }
+      return true;
+    }
+
+    template<int N, typename Mesh>
+    float BVHNBuilderTwoLevel<N,Mesh>::topLevelSAH() const
+    {
+      const float rootArea = halfArea(topNodes[0].node->bounds());
+      if (rootArea == 0.0f) return 0.0f;
+
+      /* nodes may become empty after objects got re-inserted */
+      float sah = 0.0f;
+      for (const TopLevelNode& n : topNodes) {
+        const BBox3fa bounds = n.node->bounds();
+        if (!bounds.empty()) sah += halfArea(bounds);
+      }
+      return sah/rootArea;
+    }
+
+    template<int N, typename Mesh>
+    bool BVHNBuilderTwoLevel<N,Mesh>::updateIncremental(size_t numPrimitives)
+    {
+      if (topNodes.size() == 0)
+        return false;
+
+      /* the top-level hierarchy has to contain the same objects */
+      const size_t numRefs = nextRef;
+      if (numRefs != numTopLevelObjects)
+        return false;
+
+      for (size_t i=0; i<numRefs; i++)
+        if (!objectRefs[refs[i].geomID()].referenced()) return false;
+
+      /* re-insert each modified object at the largest of its old leaves and clear all other leaves */
+      std::vector<char> dirty(topNodes.size(),false);
+      for (size_t i=0; i<numRefs; i++)
+      {
+        const unsigned int objectID = refs[i].geomID();
+        if (!modified[objectID]) continue;
+        ObjectRef& oref = objectRefs[objectID];
+
+        size_t best = oref.begin;
+        float bestArea = neg_inf;
+        for (size_t j=oref.begin; j<oref.end; j++)
+        {
+          const TopLevelLeaf& leaf = topLeaves[j];
+          const float leafArea = halfArea(topNodes[leaf.node].node->bounds(leaf.slot));
+          if (leafArea > bestArea) { best = j; bestArea = leafArea; }
+          topNodes[leaf.node].node->set(leaf.slot,BVH::emptyNode,empty);
+          dirty[leaf.node] = true;
+        }
+
+        const TopLevelLeaf& leaf = topLeaves[best];
+        topNodes[leaf.node].node->set(leaf.slot,refs[i].node,refs[i].bounds());
+        std::swap(topLeaves[oref.begin],topLeaves[best]);
+        oref.end = oref.begin+1;
+      }
+
+      /* propagate bounds towards the root, child nodes are stored after their parent */
+      for (size_t i=topNodes.size()-1; i>0; i--)
+      {
+        if (!dirty[i]) continue;
+        const TopLevelNode& n = topNodes[i];
+        topNodes[n.parent].node->setBounds(n.slot,n.node->bounds());
+        dirty[n.parent] = true;
+      }
+
+      /* rebuild if the quality of the refitted hierarchy degraded too much */
+      if (topLevelSAH() > INCREMENTAL_SAH_THRESHOLD*initialSAH)
+        return false;
+
+      bvh->set(bvh->root,LBBox3fa(topNodes[0].node->bounds()),numPrimitives);
+      return true;
+    }
+
     template<int N, typename Mesh>
     void BVHNBuilderTwoLevel<N,Mesh>::deleteGeometry(size_t geomID)
     {
       if (geomID >= objects.size()) return;
+      topNodes.clear();
       builders[geomID].clear();
       delete objects [geomID]; objects [geomID] = nullptr;
     }
@@ -288,6 +442,7 @@ namespace embree
 	if (builders[i].builder) builders[i].builder->clear();
 
       refs.clear();
+      topNodes.clear();
     }
 
     template<int N, typename Mesh>
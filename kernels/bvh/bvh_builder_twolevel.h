@@ -113,6 +113,20 @@ namespace embree
 
       void open_sequential(const size_t extSize);
 
+    private:
+
+      /*! records the top-level hierarchy after a full build for later incremental updates */
+      void setupIncrementalUpdate(std::vector<std::pair<NodeRef,unsigned int>>& leaves);
+
+      /*! gathers all top-level nodes in depth first order and all top-level leaves, returns false for unexpected nodes */
+      bool gatherTopLevelNodes(NodeRef ref, size_t parent, size_t slot, const std::vector<std::pair<NodeRef,unsigned int>>& leaves);
+
+      /*! refits the top-level hierarchy to the modified objects, returns false if a full rebuild is required */
+      bool updateIncremental(size_t numPrimitives);
+
+      /*! calculates the SAH cost of the top-level hierarchy relative to its root bounds */
+      float topLevelSAH() const;
+
     public:
       
       struct BuilderState
@@ -148,6 +162,54 @@ namespace embree
 
       typedef mvector<BuildRef> bvector;
 
+    private:
+
+      /*! node of the top-level hierarchy */
+      struct TopLevelNode
+      {
+        TopLevelNode (AlignedNode* node, size_t parent, size_t slot)
+          : node(node), parent(parent), slot(slot) {}
+
+        AlignedNode* node;  //!< pointer to the top-level node
+        size_t parent;      //!< index of the parent node, or -1 for the root
+        size_t slot;        //!< child slot of this node inside the parent node
+      };
+
+      /*! leaf of the top-level hierarchy referencing an object root or an inner node of an object */
+      struct TopLevelLeaf
+      {
+        TopLevelLeaf (unsigned int objectID, size_t node, size_t slot)
+          : objectID(objectID), node(node), slot(slot) {}
+
+        friend __forceinline bool operator< (const TopLevelLeaf& a, const TopLevelLeaf& b) {
+          return a.objectID < b.objectID;
+        }
+
+        unsigned int objectID;  //!< referenced object
+        size_t node;            //!< index of the top-level node containing the leaf
+        size_t slot;            //!< child slot of the leaf inside that node
+      };
+
+      /*! range of top-level leaves referencing some object */
+      struct ObjectRef
+      {
+        ObjectRef ()
+          : begin(0), end(0) {}
+
+        __forceinline bool referenced() const {
+          return end > begin;
+        }
+
+        size_t begin, end;
+      };
+
+      std::vector<TopLevelNode> topNodes;  //!< top-level nodes in depth first order
+      std::vector<TopLevelLeaf> topLeaves; //!< top-level leaves sorted by object
+      std::vector<ObjectRef> objectRefs;   //!< top-level leaves of each object
+      std::vector<char> modified;          //!< objects whose BVH changed in the current build
+      size_t numTopLevelObjects;           //!< number of objects in the top-level hierarchy
+      float initialSAH;                    //!< relative SAH cost of the top-level hierarchy after the last full build
+
     };
   }
 }
@@ -0,0 +1,341 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "bvh_cache.h"
+#include "../../common/algorithms/parallel_for.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+namespace embree
+{
+  namespace
+  {
+    static const char cache_magic[8] = { 'E','M','B','R','B','V','H', 0 };
+
+    /* 64 bit FNV-1a style hash over 32 bit words */
+    static const unsigned long long hash_seed  = 14695981039346656037ULL;
+    static const unsigned long long hash_prime = 1099511628211ULL;
+
+    __forceinline unsigned long long hash_combine(unsigned long long h, unsigned long long v) {
+      return (h ^ v) * hash_prime;
+    }
+
+    unsigned long long hash_string(const std::string& str)
+    {
+      unsigned long long h = hash_seed;
+      for (size_t i=0; i<str.size(); i++)
+        h = hash_combine(h,(unsigned char)str[i]);
+      return h;
+    }
+
+    /* hashes the first elementBytes bytes of each buffer element, blocks of elements are hashed in parallel */
+    unsigned long long hash_buffer(const RawBufferView& buffer, size_t elementBytes)
+    {
+      const size_t blockSize = 4096;
+      const size_t numBlocks = (buffer.size()+blockSize-1)/blockSize;
+      std::vector<unsigned long long> hashes(numBlocks);
+      parallel_for(size_t(0), numBlocks, size_t(1), [&](const range<size_t>& r)
+      {
+        for (size_t b=r.begin(); b<r.end(); b++)
+        {
+          unsigned long long h = hash_seed;
+          const size_t end = min((b+1)*blockSize,buffer.size());
+          for (size_t i=b*blockSize; i<end; i++) {
+            const unsigned int* data = (const unsigned int*) buffer.getPtr(i);
+            for (size_t j=0; j<elementBytes/4; j++)
+              h = hash_combine(h,data[j]);
+          }
+          hashes[b] = h;
+        }
+      });
+
+      unsigned long long h = hash_combine(hash_seed,buffer.size());
+      for (size_t b=0; b<numBlocks; b++)
+        h = hash_combine(h,hashes[b]);
+      return h;
+    }
+  }
+
+  template<int N>
+  BVHNCache<N>::BVHNCache (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype, const std::string& builderName)
+    : bvh(bvh), scene(scene), gtype(gtype), key(0)
+  {
+    if (scene == nullptr || !scene->isStaticAccel()) return;
+    if (scene->device->bvh_cache_dir == "") return;
+    if (!(gtype & (Geometry::MTY_TRIANGLE_MESH | Geometry::MTY_QUAD_MESH))) return;
+    key = computeKey(builderName);
+  }
+
+  template<int N>
+  unsigned long long BVHNCache<N>::computeKey(const std::string& builderName) const
+  {
+    /* hash build settings */
+    Device* device = scene->device;
+    unsigned long long h = hash_seed;
+    h = hash_combine(h,VERSION);
+    h = hash_combine(h,N);
+    h = hash_combine(h,sizeof(AlignedNode));
+    h = hash_combine(h,hash_string(bvh->primTy->name()));
+    h = hash_combine(h,hash_string(builderName));
+    h = hash_combine(h,gtype);
+    h = hash_combine(h,scene->scene_flags);
+    h = hash_combine(h,scene->quality_flags);
+    h = hash_combine(h,device->useSpatialPreSplits);
+    h = hash_combine(h,(unsigned long long)(1000.0f*device->max_spatial_split_replications));
+
+    /* hash geometry buffers of all geometries the builder will see */
+    for (size_t i=0; i<scene->size(); i++)
+    {
+      Geometry* geom = scene->get(i);
+      if (geom == nullptr || !geom->isEnabled()) continue;
+      if (!(geom->getTypeMask() & gtype) || geom->numTimeSteps != 1) continue;
+
+      h = hash_combine(h,i);
+      h = hash_combine(h,geom->getType());
+      h = hash_combine(h,geom->size());
+      h = hash_combine(h,(unsigned)geom->quality);
+
+      if (geom->getType() == Geometry::GTY_TRIANGLE_MESH) {
+        TriangleMesh* mesh = (TriangleMesh*) geom;
+        h = hash_combine(h,hash_buffer(mesh->triangles,sizeof(TriangleMesh::Triangle)));
+        h = hash_combine(h,mesh->vertices[0].getFormat());
+        h = hash_combine(h,hash_buffer(mesh->vertices[0],mesh->hasHalfVertices() ? 4*sizeof(short) : 3*sizeof(float)));
+      }
+      else if (geom->getType() == Geometry::GTY_QUAD_MESH) {
+        QuadMesh* mesh = (QuadMesh*) geom;
+        h = hash_combine(h,hash_buffer(mesh->quads,sizeof(QuadMesh::Quad)));
+        h = hash_combine(h,mesh->vertices[0].getFormat());
+        h = hash_combine(h,hash_buffer(mesh->vertices[0],mesh->hasHalfVertices() ? 4*sizeof(short) : 3*sizeof(float)));
+      }
+    }
+
+    /* key 0 marks a disabled cache */
+    return h ? h : 1;
+  }
+
+  template<int N>
+  FileName BVHNCache<N>::fileName() const
+  {
+    std::stringstream name;
+    name << "bvh" << N << "_" << bvh->primTy->name() << "_" << std::hex << key << ".bvh";
+    return FileName(scene->device->bvh_cache_dir) + name.str();
+  }
+
+  template<int N>
+  bool BVHNCache<N>::serialize(NodeRef node, std::vector<char>& buffer, size_t& ref_out)
+  {
+    if (node == BVH::emptyNode) {
+      ref_out = BVH::emptyNode;
+      return true;
+    }
+
+    if (node.isAlignedNode())
+    {
+      AlignedNode copy;
+      memcpy((void*)&copy,node.alignedNode(),sizeof(AlignedNode));
+      for (size_t c=0; c<N; c++) {
+        size_t child;
+        if (!serialize(node.alignedNode()->child(c),buffer,child)) return false;
+        copy.child(c) = NodeRef(child);
+      }
+      const size_t ofs = buffer.size();
+      buffer.resize(ofs+((sizeof(AlignedNode)+BVH::align_mask) & ~BVH::align_mask));
+      memcpy(&buffer[ofs],(void*)&copy,sizeof(AlignedNode));
+      ref_out = ofs | BVH::tyAlignedNode;
+      return true;
+    }
+
+    if (node.isLeaf())
+    {
+      size_t num; const char* prims = node.leaf(num);
+      const size_t bytes = num*bvh->primTy->getBytes(prims);
+      const size_t ofs = buffer.size();
+      buffer.resize(ofs+((bytes+BVH::align_mask) & ~BVH::align_mask));
+      memcpy(&buffer[ofs],prims,bytes);
+      ref_out = ofs | (BVH::tyLeaf+num);
+      return true;
+    }
+
+    /* other node types are not supported by the cache */
+    return false;
+  }
+
+  template<int N>
+  typename BVHNCache<N>::NodeRef BVHNCache<N>::deserialize(const char* data, size_t bytes, size_t ref, size_t depth, std::atomic<bool>& valid)
+  {
+    if (ref == BVH::emptyNode)
+      return BVH::emptyNode;
+
+    const size_t ofs = ref & ~BVH::items_mask;
+    const size_t ty  = ref &  BVH::items_mask;
+    if (depth > BVH::maxDepth || ofs >= bytes || !valid) {
+      valid = false;
+      return BVH::emptyNode;
+    }
+
+    FastAllocator::CachedAllocator alloc = bvh->alloc.getCachedAllocator();
+
+    if (ty == BVH::tyAlignedNode)
+    {
+      if (ofs+sizeof(AlignedNode) > bytes) {
+        valid = false;
+        return BVH::emptyNode;
+      }
+      AlignedNode* node = (AlignedNode*) alloc.malloc0(sizeof(AlignedNode),BVH::byteNodeAlignment);
+      memcpy((void*)node,data+ofs,sizeof(AlignedNode));
+
+      /* the upper levels of the tree are copied in parallel */
+      if (depth < 2) {
+        parallel_for(size_t(N), [&](size_t c) {
+          node->child(c) = deserialize(data,bytes,node->child(c),depth+1,valid);
+        });
+      } else {
+        for (size_t c=0; c<N; c++)
+          node->child(c) = deserialize(data,bytes,node->child(c),depth+1,valid);
+      }
+      return BVH::encodeNode(node);
+    }
+
+    if (ty > BVH::tyLeaf)
+    {
+      const size_t num = ty-BVH::tyLeaf;
+      const size_t leafBytes = num*bvh->primTy->getBytes(data+ofs);
+      if (ofs+leafBytes > bytes) {
+        valid = false;
+        return BVH::emptyNode;
+      }
+      char* prims = (char*) alloc.malloc1(leafBytes,BVH::byteAlignment);
+      memcpy(prims,data+ofs,leafBytes);
+      return BVH::encodeLeaf(prims,num);
+    }
+
+    valid = false;
+    return BVH::emptyNode;
+  }
+
+  template<int N>
+  bool BVHNCache<N>::load()
+  {
+    if (!enabled()) return false;
+
+    std::ifstream file(fileName().c_str(),std::ios::binary);
+    if (!file) return false;
+
+    /* validate header */
+    Header header;
+    file.read((char*)&header,sizeof(header));
+    if (!file) return false;
+    if (memcmp(header.magic,cache_magic,sizeof(cache_magic)) != 0) return false;
+    if (header.version != VERSION || header.branchingFactor != N || header.key != key) return false;
+    if (strncmp(header.primTy,bvh->primTy->name(),sizeof(header.primTy)) != 0) return false;
+    if (header.bytes == 0) return false;
+
+    /* read serialized nodes and leaves */
+    const size_t bytes = header.bytes;
+    char* data = (char*) alignedMalloc(bytes,64);
+    file.read(data,bytes);
+    if (!file) {
+      alignedFree(data);
+      return false;
+    }
+
+    /* copy the tree into the BVH allocator, this relocates all node references */
+    std::atomic<bool> valid(true);
+    bvh->alloc.init_estimate(bytes);
+    NodeRef root = deserialize(data,bytes,header.root,0,valid);
+    alignedFree(data);
+
+    if (!valid) {
+      bvh->clear();
+      return false;
+    }
+
+    const BBox3fa bounds(Vec3fa(header.lower[0],header.lower[1],header.lower[2]),
+                         Vec3fa(header.upper[0],header.upper[1],header.upper[2]));
+    bvh->set(root,LBBox3fa(bounds),header.numPrimitives);
+
+    if (scene->device->verbosity(2))
+    {
+      Lock<MutexSys> lock(g_printMutex);
+      std::cout << "loaded BVH" << N << "<" << bvh->primTy->name() << "> from " << fileName() << std::endl << std::flush;
+    }
+    return true;
+  }
+
+  template<int N>
+  bool BVHNCache<N>::store()
+  {
+    if (!enabled()) return false;
+
+    std::vector<char> buffer;
+    size_t root = BVH::emptyNode;
+    if (!serialize(bvh->root,buffer,root) || buffer.size() == 0)
+      return false;
+
+    Header header;
+    memset((void*)&header,0,sizeof(header));
+    memcpy(header.magic,cache_magic,sizeof(cache_magic));
+    header.version = VERSION;
+    header.branchingFactor = N;
+    header.key = key;
+    strncpy(header.primTy,bvh->primTy->name(),sizeof(header.primTy)-1);
+    header.numPrimitives = bvh->numPrimitives;
+    header.root = root;
+    header.bytes = buffer.size();
+    const BBox3fa bounds = bvh->bounds.bounds();
+    for (size_t i=0; i<3; i++) {
+      header.lower[i] = bounds.lower[i];
+      header.upper[i] = bounds.upper[i];
+    }
+
+    /* write to a temporary file first, such that concurrent processes never see partial files */
+    const FileName name = fileName();
+    std::stringstream tmpName;
+    tmpName << name.str() << "." << std::hex << (size_t)this << (size_t)(getSeconds()*1E6) << ".tmp";
+    {
+      std::ofstream file(tmpName.str().c_str(),std::ios::binary);
+      if (!file) return false;
+      file.write((const char*)&header,sizeof(header));
+      file.write(buffer.data(),buffer.size());
+      if (!file) {
+        file.close();
+        std::remove(tmpName.str().c_str());
+        return false;
+      }
+    }
+    if (std::rename(tmpName.str().c_str(),name.c_str()) != 0) {
+      std::remove(tmpName.str().c_str());
+      return false;
+    }
+
+    if (scene->device->verbosity(2))
+    {
+      Lock<MutexSys> lock(g_printMutex);
+      std::cout << "stored BVH" << N << "<" << bvh->primTy->name() << "> to " << name << std::endl << std::flush;
+    }
+    return true;
+  }
+
+#if defined(__AVX__)
+  template class BVHNCache<8>;
+#endif
+
+#if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
+  template class BVHNCache<4>;
+#endif
+}
@@ -0,0 +1,92 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bvh.h"
+#include "../../common/sys/filename.h"
+
+namespace embree
+{
+  /*! Persistent on-disk cache for BVHs of static triangle and quad
+   *  scenes. A cache file stores the aligned nodes and leaf blocks of
+   *  a BVH with all node references encoded as offsets into the
+   *  file. The file is keyed by a hash over the geometry buffers and
+   *  the build settings, thus any change of the scene results in a
+   *  cache miss. */
+  template<int N>
+  class BVHNCache
+  {
+    typedef BVHN<N> BVH;
+    typedef typename BVH::AlignedNode AlignedNode;
+    typedef typename BVH::NodeRef NodeRef;
+
+  public:
+
+    /*! version of the cache file format, increase when changing the layout */
+    static const unsigned int VERSION = 1;
+
+    /*! header of each cache file */
+    struct Header
+    {
+      char magic[8];           //!< magic file identifier
+      unsigned int version;    //!< version of the file format
+      unsigned int branchingFactor; //!< branching factor N of the BVH
+      unsigned long long key;  //!< hash of geometry buffers and build settings
+      char primTy[32];         //!< name of the leaf primitive type
+      unsigned long long numPrimitives; //!< number of primitives in the BVH
+      unsigned long long root; //!< root node reference, encoded as offset
+      unsigned long long bytes; //!< number of bytes following the header
+      float lower[3], upper[3]; //!< bounds of the BVH
+    };
+
+  public:
+
+    /*! Creates the cache for some BVH. The cache is only enabled for
+     *  scene builds of static scenes and when the bvh_cache_dir device
+     *  configuration is set. */
+    BVHNCache (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype, const std::string& builderName);
+
+    /*! returns true if the cache is enabled for this build */
+    __forceinline bool enabled() const { return key != 0; }
+
+    /*! tries to load the BVH from the cache, returns true on success */
+    bool load();
+
+    /*! stores the current BVH into the cache */
+    bool store();
+
+  private:
+
+    /*! returns the name of the cache file */
+    FileName fileName() const;
+
+    /*! calculates the key over all geometries and build settings */
+    unsigned long long computeKey(const std::string& builderName) const;
+
+    /*! serializes the subtree of some node into a buffer */
+    bool serialize(NodeRef node, std::vector<char>& buffer, size_t& ofs_out);
+
+    /*! creates a copy of some serialized subtree inside the BVH allocator */
+    NodeRef deserialize(const char* data, size_t bytes, size_t ref, size_t depth, std::atomic<bool>& valid);
+
+  private:
+    BVH* bvh;
+    Scene* scene;
+    Geometry::GTypeMask gtype;
+    unsigned long long key;
+  };
+}
@@ -0,0 +1,180 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#include "bvh_collider.h"
+#include "../common/scene.h"
+#include "../../common/algorithms/parallel_for.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! returns a mask of the children of the node whose bounds overlap the box */
+    template<int N>
+    __forceinline size_t overlap(const BBox3fa& box0, const typename BVHN<N>::AlignedNode& node1)
+    {
+      const vfloat<N> lower_x = max(vfloat<N>(box0.lower.x),node1.lower_x);
+      const vfloat<N> lower_y = max(vfloat<N>(box0.lower.y),node1.lower_y);
+      const vfloat<N> lower_z = max(vfloat<N>(box0.lower.z),node1.lower_z);
+      const vfloat<N> upper_x = min(vfloat<N>(box0.upper.x),node1.upper_x);
+      const vfloat<N> upper_y = min(vfloat<N>(box0.upper.y),node1.upper_y);
+      const vfloat<N> upper_z = min(vfloat<N>(box0.upper.z),node1.upper_z);
+      return movemask((lower_x <= upper_x) & (lower_y <= upper_y) & (lower_z <= upper_z));
+    }
+
+    template<int N>
+    void BVHNCollider<N>::collide(BVH* bvh0, BVH* bvh1)
+    {
+      if (bvh0->root == BVH::emptyNode || bvh1->root == BVH::emptyNode)
+        return;
+
+      const BBox3fa bounds0 = bvh0->bounds.bounds();
+      const BBox3fa bounds1 = bvh1->bounds.bounds();
+      if (disjoint(bounds0,bounds1))
+        return;
+
+      CollisionBatch batch(callback,userPtr);
+      collide_recurse(bvh0->root,bounds0,bvh1->root,bounds1,0,batch);
+    }
+
+    template<int N>
+    void BVHNCollider<N>::collide_pairs(const NodeRef* refs0, const BBox3fa* bounds0, const NodeRef* refs1, const BBox3fa* bounds1, size_t num, size_t depth, CollisionBatch& batch)
+    {
+      /* process child pairs in parallel close to the root, each task buffers its own collisions */
+      if (depth < PARALLEL_DEPTH && num > 1)
+      {
+        parallel_for(num, [&] (size_t i) {
+            CollisionBatch local(callback,userPtr);
+            collide_recurse(refs0[i],bounds0[i],refs1[i],bounds1[i],depth+1,local);
+          });
+      }
+      else
+      {
+        for (size_t i=0; i<num; i++)
+          collide_recurse(refs0[i],bounds0[i],refs1[i],bounds1[i],depth+1,batch);
+      }
+    }
+
+    template<int N>
+    void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, size_t depth, CollisionBatch& batch)
+    {
+      if (unlikely(ref0.isLeaf() && ref1.isLeaf())) {
+        processLeaf(ref0,ref1,batch);
+        return;
+      }
+
+      NodeRef refs0[N*N], refs1[N*N];
+      BBox3fa boxes0[N*N], boxes1[N*N];
+      size_t num = 0;
+
+      /* a subtree collides with itself, only visit each unordered child pair once */
+      if (unlikely(ref0 == ref1))
+      {
+        assert(ref0.isAlignedNode());
+        const AlignedNode* node = ref0.alignedNode();
+        for (size_t i=0; i<N; i++)
+        {
+          if (node->child(i) == BVH::emptyNode) continue;
+          const BBox3fa box0 = node->bounds(i);
+          for (size_t j=i; j<N; j++)
+          {
+            if (node->child(j) == BVH::emptyNode) continue;
+            const BBox3fa box1 = node->bounds(j);
+            if (disjoint(box0,box1)) continue;
+            refs0[num] = node->child(i); boxes0[num] = box0;
+            refs1[num] = node->child(j); boxes1[num] = box1;
+            num++;
+          }
+        }
+      }
+
+      /* otherwise descend into the larger node */
+      else if (ref1.isLeaf() || (!ref0.isLeaf() && halfArea(bounds0) >= halfArea(bounds1)))
+      {
+        assert(ref0.isAlignedNode());
+        const AlignedNode* node0 = ref0.alignedNode();
+        for (size_t mask = overlap<N>(bounds1,*node0); mask; mask &= mask-1)
+        {
+          const size_t i = bsf(mask);
+          refs0[num] = node0->child(i); boxes0[num] = node0->bounds(i);
+          refs1[num] = ref1; boxes1[num] = bounds1;
+          num++;
+        }
+      }
+      else
+      {
+        assert(ref1.isAlignedNode());
+        const AlignedNode* node1 = ref1.alignedNode();
+        for (size_t mask = overlap<N>(bounds0,*node1); mask; mask &= mask-1)
+        {
+          const size_t i = bsf(mask);
+          refs0[num] = ref0; boxes0[num] = bounds0;
+          refs1[num] = node1->child(i); boxes1[num] = node1->bounds(i);
+          num++;
+        }
+      }
+
+      collide_pairs(refs0,boxes0,refs1,boxes1,num,depth,batch);
+    }
+
+    template<int N>
+    void BVHNColliderUserGeom<N>::processLeaf(NodeRef ref0, NodeRef ref1, CollisionBatch& batch)
+    {
+      size_t num0; Object* leaf0 = (Object*) ref0.leaf(num0);
+      size_t num1; Object* leaf1 = (Object*) ref1.leaf(num1);
+      assert(num1 <= BVH::maxLeafBlocks);
+
+      /* bounds of the primitives of the second leaf are used multiple times */
+      BBox3fa bounds1[BVH::maxLeafBlocks];
+      for (size_t j=0; j<num1; j++) {
+        const AccelSet* accel1 = (const AccelSet*) this->scene1->get(leaf1[j].geomID());
+        bounds1[j] = accel1->bounds(leaf1[j].primID());
+      }
+
+      /* for self collisions of a leaf only report each pair of distinct primitives once */
+      const bool self = ref0 == ref1;
+      
+      for (size_t i=0; i<num0; i++)
+      {
+        const unsigned geomID0 = leaf0[i].geomID();
+        const unsigned primID0 = leaf0[i].primID();
+        const AccelSet* accel0 = (const AccelSet*) this->scene0->get(geomID0);
+        const BBox3fa bounds0 = accel0->bounds(primID0);
+
+        for (size_t j=self ? i+1 : 0; j<num1; j++)
+        {
+          if (disjoint(bounds0,bounds1[j])) continue;
+          batch.add(geomID0,primID0,leaf1[j].geomID(),leaf1[j].primID());
+        }
+      }
+    }
+
+    template<int N>
+    void BVHNColliderUserGeom<N>::collide(Accel::Intersectors* This0, Accel::Intersectors* This1, RTCCollideFunc callback, void* userPtr)
+    {
+      BVH* bvh0 = (BVH*) This0->ptr;
+      BVH* bvh1 = (BVH*) This1->ptr;
+      BVHNColliderUserGeom<N>(bvh0->scene,bvh1->scene,callback,userPtr).BVHNCollider<N>::collide(bvh0,bvh1);
+    }
+
+    DEFINE_COLLIDER(BVH4ColliderUserGeom,BVHNColliderUserGeom<4>);
+
+#if defined(__AVX__)
+    DEFINE_COLLIDER(BVH8ColliderUserGeom,BVHNColliderUserGeom<8>);
+#endif
+  }
+}
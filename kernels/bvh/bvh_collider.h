@@ -0,0 +1,124 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "bvh.h"
+#include "../geometry/object.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Finds all pairs of primitives with overlapping bounds of two
+     *  BVHs by traversing both BVHs simultaneously. */
+    template<int N>
+    class BVHNCollider
+    {
+      /* Type shortcuts */
+      typedef BVHN<N> BVH;
+      typedef typename BVH::AlignedNode AlignedNode;
+      typedef typename BVH::NodeRef NodeRef;
+
+      /*! number of collisions passed to the callback at once */
+      static const size_t COLLISION_BATCH_SIZE = 16;
+
+      /*! traversal depth up to which child pairs are processed in parallel */
+      static const size_t PARALLEL_DEPTH = 3;
+
+    protected:
+
+      /*! buffers collisions and passes them in batches to the callback */
+      struct CollisionBatch
+      {
+        __forceinline CollisionBatch (RTCCollideFunc callback, void* userPtr)
+          : callback(callback), userPtr(userPtr), num(0) {}
+
+        __forceinline ~CollisionBatch() {
+          flush();
+        }
+
+        __forceinline void add(unsigned geomID0, unsigned primID0, unsigned geomID1, unsigned primID1)
+        {
+          if (unlikely(num == COLLISION_BATCH_SIZE)) flush();
+          RTCCollision& c = collisions[num++];
+          c.geomID0 = geomID0; c.primID0 = primID0;
+          c.geomID1 = geomID1; c.primID1 = primID1;
+        }
+
+        __forceinline void flush()
+        {
+          if (num == 0) return;
+          callback(userPtr,collisions,(unsigned int)num);
+          num = 0;
+        }
+
+      private:
+        RTCCollideFunc callback;
+        void* userPtr;
+        size_t num;
+        RTCCollision collisions[COLLISION_BATCH_SIZE];
+      };
+
+    public:
+      BVHNCollider (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
+        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr) {}
+
+      virtual ~BVHNCollider() {}
+
+      /*! reports all colliding primitive pairs of the two BVHs */
+      void collide(BVH* bvh0, BVH* bvh1);
+
+    private:
+
+      /*! recursively traverses two subtrees with overlapping bounds */
+      void collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, size_t depth, CollisionBatch& batch);
+
+      /*! processes a list of subtree pairs, in parallel at the top of the hierarchy */
+      void collide_pairs(const NodeRef* refs0, const BBox3fa* bounds0, const NodeRef* refs1, const BBox3fa* bounds1, size_t num, size_t depth, CollisionBatch& batch);
+
+    protected:
+
+      /*! reports all colliding primitive pairs of two leaves */
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, CollisionBatch& batch) = 0;
+
+    protected:
+      Scene* scene0;
+      Scene* scene1;
+      RTCCollideFunc callback;
+      void* userPtr;
+    };
+
+    /*! Collider for BVHs over user geometries. */
+    template<int N>
+    class BVHNColliderUserGeom : public BVHNCollider<N>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVHNCollider<N>::CollisionBatch CollisionBatch;
+
+    public:
+      BVHNColliderUserGeom (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
+        : BVHNCollider<N>(scene0,scene1,callback,userPtr) {}
+
+      static void collide(Accel::Intersectors* This0, Accel::Intersectors* This1, RTCCollideFunc callback, void* userPtr);
+
+    protected:
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, CollisionBatch& batch) override;
+    };
+  }
+}
@@ -23,6 +23,7 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/triangleq_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
 #include "../geometry/curveNv_intersector.h"
@@ -58,7 +59,7 @@ namespace embree
       StackItemT<NodeRef> stack[stackSize];    // stack of nodes
       StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
       StackItemT<NodeRef>* stackEnd = stack+stackSize;
-      stack[0].ptr  = bvh->root;
+      stack[0].ptr  = bvh->getRoot();
       stack[0].dist = neg_inf;
       
       if (bvh->root == BVH::emptyNode)
@@ -153,7 +154,7 @@ namespace embree
       NodeRef stack[stackSize];    // stack of nodes that still need to get traversed
       NodeRef* stackPtr = stack+1; // current stack pointer
       NodeRef* stackEnd = stack+stackSize;
-      stack[0] = bvh->root;
+      stack[0] = bvh->getRoot();
 
       /* filter out invalid rays */
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
@@ -213,5 +214,99 @@ namespace embree
         }
       }
     }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    bool BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::pointQuery(const Accel::Intersectors* __restrict__ This,
+                                                                               PointQuery* __restrict__ query,
+                                                                               PointQueryContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+
+      /* we may traverse an empty BVH in case all geometry was invalid */
+      if (bvh->root == BVH::emptyNode)
+        return false;
+
+      /* verify correct input */
+      assert(!(types & BVH_MB) || (query->time >= 0.0f && query->time <= 1.0f));
+
+      /* stack state */
+      StackItemT<NodeRef> stack[stackSize];    // stack of nodes
+      StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
+      stack[0].ptr  = bvh->getRoot();
+      stack[0].dist = neg_inf;
+
+      /* load the point query into SIMD registers */
+      TravPointQuery<N> tquery(query->p,query->radius);
+      bool changed = false;
+
+      /* pop loop */
+      while (true) pop:
+      {
+        /* pop next node */
+        if (unlikely(stackPtr == stack)) break;
+        stackPtr--;
+        NodeRef cur = NodeRef(stackPtr->ptr);
+
+        /* if popped node is outside the shrunken query sphere, pop next one */
+        if (unlikely(*(float*)&stackPtr->dist > tquery.rad2[0]))
+          continue;
+
+        /* downtraversal loop */
+        while (true)
+        {
+          /* cull children against the query sphere */
+          size_t mask; vfloat<N> dist;
+          bool nodeIntersected = BVHNNodePointQuery1<N, types>::pointQuery(cur, tquery, query->time, dist, mask);
+          if (unlikely(!nodeIntersected)) break;
+
+          /* if no child overlaps the sphere, pop next node */
+          if (unlikely(mask == 0))
+            goto pop;
+
+          /* select closest child and push other children sorted by distance */
+          const typename BVH::BaseNode* node = cur.baseNode(types);
+          size_t r = bscf(mask);
+          cur = node->child(r);
+          if (likely(mask == 0)) {
+            cur.prefetch(types);
+            continue;
+          }
+          const vint<N> idist = asInt(dist);
+          StackItemT<NodeRef>* stackFirst = stackPtr;
+          stackPtr->ptr = cur; stackPtr->dist = idist[r]; stackPtr++;
+          do {
+            r = bscf(mask);
+            assert(stackPtr < stack+stackSize);
+            stackPtr->ptr = node->child(r); stackPtr->dist = idist[r]; stackPtr++;
+          } while (mask);
+
+          /* sort in descending order such that the closest child is on top,
+           * squared distances are positive thus can get compared as integers */
+          for (StackItemT<NodeRef>* i = stackFirst+1; i<stackPtr; i++)
+            for (StackItemT<NodeRef>* j = i; j>stackFirst && (j-1)->dist < j->dist; j--)
+              StackItemT<NodeRef>::xchg(*(j-1),*j);
+
+          stackPtr--;
+          cur = NodeRef(stackPtr->ptr);
+        }
+
+        /* this is a leaf node */
+        assert(cur != BVH::emptyNode);
+        size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        size_t lazy_node = 0;
+        if (PrimitiveIntersector1::pointQuery(This, query, context, prim, num, tquery, lazy_node)) {
+          changed = true;
+          tquery.setRadius(query->radius);
+        }
+
+        /* push lazy node onto stack */
+        if (unlikely(lazy_node)) {
+          stackPtr->ptr = lazy_node;
+          stackPtr->dist = neg_inf;
+          stackPtr++;
+        }
+      }
+      return changed;
+    }
   }
 }
@@ -21,6 +21,7 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/triangleq_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
 #include "../geometry/linei_intersector.h"
@@ -89,7 +90,7 @@ namespace embree
 
       stack[0].mask   = m_active;
       stack[0].parent = 0;
-      stack[0].child  = bvh->root;
+      stack[0].child  = bvh->getRoot();
 
       ///////////////////////////////////////////////////////////////////////////////////
       ///////////////////////////////////////////////////////////////////////////////////
@@ -217,7 +218,7 @@ namespace embree
 
       stack[0].mask   = m_active;
       stack[0].parent = 0;
-      stack[0].child  = bvh->root;
+      stack[0].child  = bvh->getRoot();
 
       ///////////////////////////////////////////////////////////////////////////////////
       ///////////////////////////////////////////////////////////////////////////////////
@@ -328,7 +329,7 @@ namespace embree
 
       StackItemMaskT<NodeRef> stack[stackSizeSingle]; // stack of nodes
       StackItemMaskT<NodeRef>* stackPtr = stack + 1;  // current stack pointer
-      stack[0].ptr = bvh->root;
+      stack[0].ptr = bvh->getRoot();
       stack[0].mask = m_active;
 
       size_t terminated = ~m_active;
@@ -441,6 +442,11 @@ namespace embree
       template<int K> using Type = ArrayIntersectorKStream<K,TriangleMiIntersectorKMoeller<SIMD_MODE(4) COMMA K COMMA true>>;
     };
 
+    template<bool filter>
+    struct Triangle4qIntersectorStreamMoeller {
+      template<int K> using Type = ArrayIntersectorKStream<K,TriangleMqIntersectorKMoeller<SIMD_MODE(4) COMMA K COMMA true>>;
+    };
+
     template<bool filter>
     struct Triangle4iIntersectorStreamPluecker {
       template<int K> using Type = ArrayIntersectorKStream<K,TriangleMiIntersectorKPluecker<SIMD_MODE(4) COMMA K COMMA true>>;
@@ -17,15 +17,107 @@
 #include "bvh_intersector_stream_filters.h"
 #include "bvh_intersector_stream.h"
 
+#include <algorithm>
+
 namespace embree
 {
   namespace isa
   {
+    /*! Sorts the rays of an incoherent stream by direction octant and
+     *  Morton code of the ray origin, and traces groups of rays of the
+     *  same octant as coherent streams. Rays are identified by their
+     *  offset or index into the input stream as returned by getRayID. */
+    template<int K, bool intersect, typename GetRayID, typename GetRay, typename GetRayK, typename SetHitK>
+    __forceinline void RayStreamFilter::filterSorted(Scene* scene, size_t N, const GetRayID& getRayID, const GetRay& getRay, const GetRayK& getRayK, const SetHitK& setHitK, IntersectContext* context)
+    {
+      __aligned(64) unsigned long long keys[MAX_SORTED_STREAM_SIZE];
+      __aligned(64) unsigned int rayIDs[MAX_SORTED_STREAM_SIZE];
+      __aligned(64) unsigned int groupIDs[MAX_INTERNAL_STREAM_SIZE];
+      __aligned(64) RayTypeK<K, intersect> rays[MAX_INTERNAL_STREAM_SIZE / K];
+      __aligned(64) RayTypeK<K, intersect>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+
+      const size_t sortSize = clamp(scene->device->stream_sort_size, MAX_INTERNAL_STREAM_SIZE, MAX_SORTED_STREAM_SIZE);
+
+      /* map ray origins to a 1024^3 grid over the scene bounds */
+      const BBox3fa bounds = scene->bounds.bounds();
+      const Vec3fa diag = bounds.size();
+      const Vec3fa scale = select(gt_mask(diag,Vec3fa(1E-19f)),Vec3fa(1023.99f)*rcp(diag),Vec3fa(0.0f));
+
+      for (size_t i = 0; i < N; i += sortSize)
+      {
+        /* calculate sort keys for all valid rays */
+        const size_t size = min(N - i, sortSize);
+        size_t numRays = 0;
+        for (size_t j = 0; j < size; j++)
+        {
+          const unsigned int rayID = getRayID(i+j);
+          const Ray ray = getRay(rayID);
+
+          /* skip invalid rays */
+          if (unlikely(ray.tnear() > ray.tfar)) continue;
+          if (unlikely(!intersect && ray.tfar < 0.0f)) continue; // ignore already occluded rays
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+          if (unlikely(!ray.valid())) continue;
+#endif
+
+          const unsigned int octantID = movemask(vfloat4(Vec3fa(ray.dir)) < 0.0f) & 0x7;
+          const Vec3fa cell = clamp((Vec3fa(ray.org)-bounds.lower)*scale,Vec3fa(0.0f),Vec3fa(1023.0f));
+          const unsigned int code = bitInterleave((unsigned int)cell.x,(unsigned int)cell.y,(unsigned int)cell.z);
+          keys[numRays] = ((unsigned long long)octantID << 61) | ((unsigned long long)code << 31) | (unsigned long long)numRays;
+          rayIDs[numRays] = rayID;
+          numRays++;
+        }
+        std::sort(keys,keys+numRays);
+
+        /* trace groups of rays with the same octant as coherent streams */
+        for (size_t j = 0; j < numRays;)
+        {
+          const unsigned long long octantID = keys[j] >> 61;
+          unsigned int numGroupRays = 0;
+          for (; j < numRays && numGroupRays < MAX_INTERNAL_STREAM_SIZE && (keys[j] >> 61) == octantID; j++)
+            groupIDs[numGroupRays++] = rayIDs[keys[j] & 0x7fffffff];
+
+          for (unsigned int k = 0; k < numGroupRays; k += K)
+          {
+            const vint<K> vi = vint<K>(int(k)) + vint<K>(step);
+            const vbool<K> valid = vi < vint<K>(int(numGroupRays));
+            const vint<K> ids = *(vint<K>*)&groupIDs[k];
+            RayTypeK<K, intersect>& ray = rays[k/K];
+            rayPtrs[k/K] = &ray;
+            ray = getRayK(valid, ids);
+            ray.tnear() = select(valid, ray.tnear(), zero);
+            ray.tfar  = select(valid, ray.tfar,  neg_inf);
+          }
+
+          scene->intersectors.intersectN(rayPtrs, numGroupRays, context);
+
+          for (unsigned int k = 0; k < numGroupRays; k += K)
+          {
+            const vint<K> vi = vint<K>(int(k)) + vint<K>(step);
+            const vbool<K> valid = vi < vint<K>(int(numGroupRays));
+            const vint<K> ids = *(vint<K>*)&groupIDs[k];
+            setHitK(valid, ids, rays[k/K]);
+          }
+        }
+      }
+    }
+
     template<int K, bool intersect>
     __noinline void RayStreamFilter::filterAOS(Scene* scene, void* _rayN, size_t N, size_t stride, IntersectContext* context)
     {
       RayStreamAOS rayN(_rayN);
 
+      /* sort incoherent rays into coherent streams */
+      if (unlikely(context->isSorted()))
+      {
+        filterSorted<K, intersect>(scene, N, [&] (size_t i) { return (unsigned int)(i * stride); },
+          [&] (unsigned int rayID) -> Ray { return rayN.getRayByOffset(rayID); },
+          [&] (const vbool<K>& valid, const vint<K>& rayID) -> RayTypeK<K, intersect> { return rayN.getRayByOffset(valid, rayID); },
+          [&] (const vbool<K>& valid, const vint<K>& rayID, const RayTypeK<K, intersect>& ray) { rayN.setHitByOffset(valid, rayID, ray); },
+          context);
+        return;
+      }
+
       /* use fast path for coherent ray mode */
       if (unlikely(context->isCoherent()))
       {
@@ -169,6 +261,17 @@ namespace embree
     {
       RayStreamAOP rayN(_rayN);
 
+      /* sort incoherent rays into coherent streams */
+      if (unlikely(context->isSorted()))
+      {
+        filterSorted<K, intersect>(scene, N, [&] (size_t i) { return (unsigned int)i; },
+          [&] (unsigned int rayID) -> Ray { return rayN.getRayByIndex(rayID); },
+          [&] (const vbool<K>& valid, const vint<K>& rayID) -> RayTypeK<K, intersect> { return rayN.getRayByIndex(valid, rayID); },
+          [&] (const vbool<K>& valid, const vint<K>& rayID, const RayTypeK<K, intersect>& ray) { rayN.setHitByIndex(valid, rayID, ray); },
+          context);
+        return;
+      }
+
       /* use fast path for coherent ray mode */
       if (unlikely(context->isCoherent()))
       {
@@ -308,6 +411,18 @@ namespace embree
     template<int K, bool intersect>
     __noinline void RayStreamFilter::filterSOA(Scene* scene, char* rayData, size_t N, size_t numPackets, size_t stride, IntersectContext* context)
     {
+      /* sort incoherent rays into coherent streams */
+      if (unlikely(context->isSorted()))
+      {
+        RayStreamSOA rayN(rayData, N);
+        filterSorted<K, intersect>(scene, N*numPackets, [&] (size_t i) { return (unsigned int)((i / N) * stride + (i % N) * sizeof(float)); },
+          [&] (unsigned int rayID) -> Ray { return rayN.getRayByOffset(rayID); },
+          [&] (const vbool<K>& valid, const vint<K>& rayID) -> RayTypeK<K, intersect> { return rayN.getRayByOffset(valid, rayID); },
+          [&] (const vbool<K>& valid, const vint<K>& rayID, const RayTypeK<K, intersect>& ray) { rayN.setHitByOffset(valid, rayID, ray); },
+          context);
+        return;
+      }
+
       const size_t rayDataAlignment = (size_t)rayData % (K*sizeof(float));
       const size_t offsetAlignment  = (size_t)stride  % (K*sizeof(float));
 
@@ -465,6 +580,17 @@ namespace embree
     { 
       RayStreamSOP& rayN = *(RayStreamSOP*)_rayN;
 
+      /* sort incoherent rays into coherent streams */
+      if (unlikely(context->isSorted()))
+      {
+        filterSorted<K, intersect>(scene, N, [&] (size_t i) { return (unsigned int)(i * sizeof(float)); },
+          [&] (unsigned int rayID) -> Ray { return rayN.getRayByOffset(rayID); },
+          [&] (const vbool<K>& valid, const vint<K>& rayID) -> RayTypeK<K, intersect> { return rayN.getRayByOffset(valid, rayID); },
+          [&] (const vbool<K>& valid, const vint<K>& rayID, const RayTypeK<K, intersect>& ray) { rayN.setHitByOffset(valid, rayID, ray); },
+          context);
+        return;
+      }
+
       /* use fast path for coherent ray mode */
       if (unlikely(context->isCoherent()))
       {
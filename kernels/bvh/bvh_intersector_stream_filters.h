@@ -38,6 +38,9 @@ namespace embree
       static void occludedSOP(Scene* scene, const RTCRayNp* rays, size_t N, IntersectContext* context);
 
     private:
+      template<int K, bool intersect, typename GetRayID, typename GetRay, typename GetRayK, typename SetHitK>
+      static void filterSorted(Scene* scene, size_t N, const GetRayID& getRayID, const GetRay& getRay, const GetRayK& getRayK, const SetHitK& setHitK, IntersectContext* context);
+
       template<int K, bool intersect>
       static void filterAOS(Scene* scene, void* rays, size_t N, size_t stride, IntersectContext* context);
 
@@ -40,7 +40,7 @@ namespace embree
 
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0), validVertexRanges(false)
     {
     }
 
@@ -68,6 +68,47 @@ namespace embree
       }    
   }
 
+    template<int N>
+    void BVHNRefitter<N>::refit(const range<size_t>& vertices)
+    {
+      if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD) {
+        refit();
+        return;
+      }
+
+      BBox3fa subTreeBounds[MAX_NUM_SUB_TREES];
+      numSubTrees = 0;
+      gather_subtree_refs(bvh->root,numSubTrees,0);
+
+      /* the subtrees do not change between refits, thus their vertex ranges are only calculated once after each rebuild */
+      if (!validVertexRanges)
+      {
+        parallel_for(size_t(0), numSubTrees, size_t(1), [&](const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++)
+              subTreeVertexRanges[i] = vertex_range(subTrees[i]);
+          });
+        validVertexRanges = true;
+      }
+
+      /* refit only the subtrees that reference modified vertices, all others keep their old bounds */
+      if (numSubTrees)
+        parallel_for(size_t(0), numSubTrees, size_t(1), [&](const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              NodeRef& ref = subTrees[i];
+              if (!subTreeVertexRanges[i].intersect(vertices).empty())
+                subTreeBounds[i] = recurse_bottom(ref);
+              else if (ref.isAlignedNode())
+                subTreeBounds[i] = ref.alignedNode()->bounds();
+              else
+                subTreeBounds[i] = leafBounds.leafBounds(ref);
+            }
+          });
+
+      numSubTrees = 0;
+      bvh->bounds = LBBox3fa(refit_toplevel(bvh->root,numSubTrees,subTreeBounds,0));
+    }
+
     template<int N>
     void BVHNRefitter<N>::gather_subtree_refs(NodeRef& ref,
                                               size_t &subtrees,
@@ -178,23 +219,116 @@ namespace embree
       return merge<N>(bounds);
     }
 
+    template<int N>
+    range<size_t> BVHNRefitter<N>::vertex_range(NodeRef& ref)
+    {
+      if (unlikely(ref.isLeaf()))
+        return leafBounds.leafVertexRange(ref);
+
+      AlignedNode* node = ref.alignedNode();
+      size_t begin = size_t(-1), end = 0;
+      for (size_t i=0; i<N; i++)
+      {
+        if (unlikely(node->child(i) == BVH::emptyNode)) continue;
+        const range<size_t> r = vertex_range(node->child(i));
+        if (r.empty()) continue;
+        begin = min(begin,r.begin());
+        end   = max(end,r.end());
+      }
+      return begin < end ? range<size_t>(begin,end) : range<size_t>(0,0);
+    }
+
+    /* returns the range of vertices referenced by some primitive */
+    __forceinline range<size_t> primVertexRange(const TriangleMesh* mesh, unsigned int primID)
+    {
+      const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+      return range<size_t>(min(tri.v[0],tri.v[1],tri.v[2]),size_t(max(tri.v[0],tri.v[1],tri.v[2]))+1);
+    }
+
+    __forceinline range<size_t> primVertexRange(const QuadMesh* mesh, unsigned int primID)
+    {
+      const QuadMesh::Quad& quad = mesh->quad(primID);
+      return range<size_t>(min(quad.v[0],quad.v[1],quad.v[2],quad.v[3]),size_t(max(quad.v[0],quad.v[1],quad.v[2],quad.v[3]))+1);
+    }
+
+    /* returns the range of vertices referenced by the primitives of some leaf */
+    template<typename Mesh, typename Primitive>
+    __forceinline range<size_t> leafVertexRangeT(const Mesh* mesh, const Primitive* prims, size_t num)
+    {
+      size_t begin = size_t(-1), end = 0;
+      for (size_t i=0; i<num; i++)
+      {
+        for (size_t j=0; j<Primitive::max_size(); j++)
+        {
+          if (!prims[i].valid(j)) continue;
+          const range<size_t> r = primVertexRange(mesh,prims[i].primID(j));
+          begin = min(begin,r.begin());
+          end   = max(end,r.end());
+        }
+      }
+      return begin < end ? range<size_t>(begin,end) : range<size_t>(0,0);
+    }
+
+    /* user geometries reference no vertices, thus their leaves are conservatively marked as referencing all vertices */
+    template<typename Primitive>
+    __forceinline range<size_t> leafVertexRangeT(const UserGeometry* mesh, const Primitive* prims, size_t num) {
+      return range<size_t>(0,size_t(-1));
+    }
+
+    /* returns the range of vertices modified since the last commit, returns false if the entire mesh has to get refit */
+    template<typename Mesh>
+    __forceinline bool modifiedVertexRange(const Mesh* mesh, range<size_t>& vertices)
+    {
+      size_t begin = size_t(-1), end = 0;
+      for (size_t t=0; t<mesh->vertices.size(); t++)
+      {
+        if (!mesh->vertices[t].isModified()) continue;
+        const range<size_t> r = mesh->vertices[t].getModifiedRange();
+        begin = min(begin,r.begin());
+        end   = max(end,r.end());
+      }
+
+      /* refit everything if no vertex buffer got marked as modified or if the entire buffer got modified */
+      if (begin >= end) return false;
+      if (begin == 0 && end >= mesh->numVertices()) return false;
+      vertices = range<size_t>(begin,end);
+      return true;
+    }
+
+    __forceinline bool modifiedVertexRange(const UserGeometry* mesh, range<size_t>& vertices) {
+      return false;
+    }
+
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
       : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh) {}
 
+    template<int N, typename Mesh, typename Primitive>
+    const range<size_t> BVHNRefitT<N,Mesh,Primitive>::leafVertexRange (NodeRef& ref) const
+    {
+      size_t num; char* prim = ref.leaf(num);
+      if (unlikely(ref == BVH::emptyNode)) return range<size_t>(0,0);
+      return leafVertexRangeT(mesh,(Primitive*)prim,num);
+    }
+
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::clear()
     {
       if (builder) 
         builder->clear();
+      refitter->clearVertexRanges();
     }
     
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::build()
     {
+      range<size_t> vertices;
       if (mesh->topologyChanged()) {
         builder->build();
+        refitter->clearVertexRanges();
       }
+      else if (modifiedVertexRange(mesh,vertices))
+        refitter->refit(vertices);
       else
         refitter->refit();
     }
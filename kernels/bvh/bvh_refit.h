@@ -34,6 +34,7 @@ namespace embree
 
       struct LeafBoundsInterface {
         virtual const BBox3fa leafBounds(NodeRef& ref) const = 0;
+        virtual const range<size_t> leafVertexRange(NodeRef& ref) const = 0;
       };
 
     public:
@@ -44,6 +45,12 @@ namespace embree
       /*! refits the BVH */
       void refit();
 
+      /*! refits only the subtrees of the BVH that reference vertices of the specified range */
+      void refit(const range<size_t>& vertices);
+
+      /*! invalidates the cached vertex ranges of the subtrees, has to get called when the BVH got rebuilt */
+      void clearVertexRanges() { validVertexRanges = false; }
+
     private:
       /* single-threaded subtree extraction based on BVH depth */
       void gather_subtree_refs(NodeRef& ref, 
@@ -58,6 +65,9 @@ namespace embree
 
       /* single-threaded subtree refit */
       BBox3fa recurse_bottom(NodeRef& ref);
+
+      /* single-threaded calculation of the vertex range referenced by a subtree */
+      range<size_t> vertex_range(NodeRef& ref);
       
     public:
       BVH* bvh;                              //!< BVH to refit
@@ -67,6 +77,8 @@ namespace embree
       static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 256 : (N==8) ? 512 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
       size_t numSubTrees;
       NodeRef subTrees[MAX_NUM_SUB_TREES];
+      range<size_t> subTreeVertexRanges[MAX_NUM_SUB_TREES]; //!< vertex range referenced by each subtree
+      bool validVertexRanges;                                //!< true if the subtree vertex ranges are up to date
     };
 
     template<int N, typename Mesh, typename Primitive>
@@ -96,6 +108,8 @@ namespace embree
             bounds.extend(((Primitive*)prim)[i].update(mesh));
         return bounds;
       }
+
+      virtual const range<size_t> leafVertexRange (NodeRef& ref) const;
       
     private:
       BVH* bvh;
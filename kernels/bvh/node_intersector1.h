@@ -1035,6 +1035,192 @@ namespace embree
       return movemask(vmask);
     }
 
+    //////////////////////////////////////////////////////////////////////////////////////
+    // Point query structure used in single point query traversal
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N>
+      struct TravPointQuery
+    {
+      __forceinline TravPointQuery() {}
+
+      __forceinline TravPointQuery(const Vec3fa& query_org, const float query_radius)
+      {
+        org = Vec3vf<N>(query_org.x,query_org.y,query_org.z);
+        rad2 = vfloat<N>(query_radius*query_radius);
+      }
+
+      __forceinline void setRadius(const float query_radius) {
+        rad2 = vfloat<N>(query_radius*query_radius);
+      }
+
+      Vec3vf<N> org;
+      vfloat<N> rad2;
+    };
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // Point query node culling
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    /*! calculates the squared distance of the query point to N boxes and
+     *  returns the mask of valid boxes that overlap the query sphere */
+    template<int N>
+      __forceinline size_t pointQueryNodeSphere(const vfloat<N>& lower_x, const vfloat<N>& lower_y, const vfloat<N>& lower_z,
+                                                const vfloat<N>& upper_x, const vfloat<N>& upper_y, const vfloat<N>& upper_z,
+                                                const TravPointQuery<N>& query, vfloat<N>& dist)
+    {
+      const vfloat<N> dx = max(max(lower_x-query.org.x,query.org.x-upper_x),vfloat<N>(zero));
+      const vfloat<N> dy = max(max(lower_y-query.org.y,query.org.y-upper_y),vfloat<N>(zero));
+      const vfloat<N> dz = max(max(lower_z-query.org.z,query.org.z-upper_z),vfloat<N>(zero));
+      const vfloat<N> d2 = madd(dx,dx,madd(dy,dy,dz*dz));
+      const vbool<N> vmask = (lower_x <= upper_x) & (d2 <= query.rad2);
+      dist = d2;
+      return movemask(vmask);
+    }
+
+    template<int N>
+      __forceinline size_t pointQueryNode(const typename BVHN<N>::AlignedNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
+    {
+      return pointQueryNodeSphere<N>(node->lower_x,node->lower_y,node->lower_z,
+                                     node->upper_x,node->upper_y,node->upper_z,query,dist);
+    }
+
+    template<int N>
+      __forceinline size_t pointQueryNode(const typename BVHN<N>::AlignedNodeMB* node, const TravPointQuery<N>& query, const float time, vfloat<N>& dist)
+    {
+      const vfloat<N> vtime(time);
+      return pointQueryNodeSphere<N>(madd(vtime,node->lower_dx,node->lower_x),
+                                     madd(vtime,node->lower_dy,node->lower_y),
+                                     madd(vtime,node->lower_dz,node->lower_z),
+                                     madd(vtime,node->upper_dx,node->upper_x),
+                                     madd(vtime,node->upper_dy,node->upper_y),
+                                     madd(vtime,node->upper_dz,node->upper_z),query,dist);
+    }
+
+    template<int N>
+      __forceinline size_t pointQueryNodeMB4D(const typename BVHN<N>::NodeRef ref, const TravPointQuery<N>& query, const float time, vfloat<N>& dist)
+    {
+      size_t mask = pointQueryNode<N>(ref.alignedNodeMB(),query,time,dist);
+      if (unlikely(ref.isAlignedNodeMB4D())) {
+        const typename BVHN<N>::AlignedNodeMB4D* node1 = ref.alignedNodeMB4D();
+        mask &= movemask((node1->lower_t <= time) & (time < node1->upper_t));
+      }
+      return mask;
+    }
+
+    template<int N>
+      __forceinline size_t pointQueryNode(const typename BVHN<N>::QuantizedBaseNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
+    {
+      const size_t mask = pointQueryNodeSphere<N>(node->dequantizeLowerX(),node->dequantizeLowerY(),node->dequantizeLowerZ(),
+                                                  node->dequantizeUpperX(),node->dequantizeUpperY(),node->dequantizeUpperZ(),query,dist);
+      return mask & movemask(node->validMask());
+    }
+
+    template<int N>
+      __forceinline size_t pointQueryNode(const typename BVHN<N>::QuantizedBaseNodeMB* node, const TravPointQuery<N>& query, const float time, vfloat<N>& dist)
+    {
+      const vfloat<N> t(time);
+      const size_t mask = pointQueryNodeSphere<N>(node->dequantizeLowerX(t),node->dequantizeLowerY(t),node->dequantizeLowerZ(t),
+                                                  node->dequantizeUpperX(t),node->dequantizeUpperY(t),node->dequantizeUpperZ(t),query,dist);
+      return mask & movemask(node->validMask());
+    }
+
+    /*! unaligned nodes store no world space bounds, thus all valid
+     *  children are conservatively reported as overlapping */
+    template<int N, typename UnalignedNode>
+      __forceinline size_t pointQueryNodeUnaligned(const UnalignedNode* node, vfloat<N>& dist)
+    {
+      size_t mask = 0;
+      for (size_t i=0; i<N; i++)
+        if (node->child(i) != BVHN<N>::emptyNode) mask |= size_t(1) << i;
+      dist = vfloat<N>(zero);
+      return mask;
+    }
+
+    /*! Culls N nodes against the sphere of 1 point query */
+    template<int N, int types>
+    struct BVHNNodePointQuery1;
+
+    template<int N>
+    struct BVHNNodePointQuery1<N, BVH_AN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNode<N>(node.alignedNode(), query, dist);
+        return true;
+      }
+    };
+
+    template<int N>
+    struct BVHNNodePointQuery1<N, BVH_AN2>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNode<N>(node.alignedNodeMB(), query, time, dist);
+        return true;
+      }
+    };
+
+    template<int N>
+    struct BVHNNodePointQuery1<N, BVH_AN2_AN4D>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNodeMB4D<N>(node, query, time, dist);
+        return true;
+      }
+    };
+
+    template<int N>
+    struct BVHNNodePointQuery1<N, BVH_AN1_UN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (likely(node.isAlignedNode()))          mask = pointQueryNode<N>(node.alignedNode(), query, dist);
+        else if (unlikely(node.isUnalignedNode())) mask = pointQueryNodeUnaligned<N>(node.unalignedNode(), dist);
+        else return false;
+        return true;
+      }
+    };
+
+    template<int N>
+    struct BVHNNodePointQuery1<N, BVH_AN2_UN2>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (likely(node.isAlignedNodeMB()))           mask = pointQueryNode<N>(node.alignedNodeMB(), query, time, dist);
+        else if (unlikely(node.isUnalignedNodeMB()))  mask = pointQueryNodeUnaligned<N>(node.unalignedNodeMB(), dist);
+        else return false;
+        return true;
+      }
+    };
+
+    template<int N>
+    struct BVHNNodePointQuery1<N, BVH_AN2_AN4D_UN2>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (unlikely(node.isUnalignedNodeMB())) mask = pointQueryNodeUnaligned<N>(node.unalignedNodeMB(), dist);
+        else                                    mask = pointQueryNodeMB4D<N>(node, query, time, dist);
+        return true;
+      }
+    };
+
+    template<int N>
+    struct BVHNNodePointQuery1<N, BVH_QN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNode<N>((const typename BVHN<N>::QuantizedBaseNode*)node.quantizedNode(), query, dist);
+        return true;
+      }
+    };
+
     //////////////////////////////////////////////////////////////////////////////////////
     // Node intersectors used in ray traversal
     //////////////////////////////////////////////////////////////////////////////////////
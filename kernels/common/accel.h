@@ -23,6 +23,8 @@
 namespace embree
 {
   class Scene;
+  struct PointQuery;
+  struct PointQueryContext;
 
   /*! Base class for the acceleration structure data. */
   class AccelData : public RefCount 
@@ -41,6 +43,9 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! replicates the acceleration structure into the memory of each NUMA node */
+    virtual void replicate() {};
+
     /*! returns normal bounds */
     __forceinline BBox3fa getBounds() const {
       return bounds.bounds();
@@ -127,6 +132,11 @@ namespace embree
                                     RTCRay16& ray,      /*!< ray packet to test occlusion. */
                                     IntersectContext* context);
 
+    /*! Type of point query function pointer. */
+    typedef bool (*PointQueryFunc)(Intersectors* This,          /*!< this pointer to accel */
+                                   PointQuery* query,           /*!< point query for lookup */
+                                   PointQueryContext* context); /*!< point query context */
+
     /*! Type of intersect function pointer for ray packets of size N. */
     typedef void (*OccludedFuncN)(Intersectors* This, /*!< this pointer to accel */
                                   RTCRayN** ray,      /*!< ray stream to test occlusion */
@@ -134,13 +144,22 @@ namespace embree
                                   IntersectContext* context /*!< layout flags */);
     typedef void (*ErrorFunc) ();
 
+    /*! Type of collide function pointer. */
+    typedef void (*CollideFunc) (Intersectors* This0,    /*!< this pointer to first accel */
+                                 Intersectors* This1,    /*!< this pointer to second accel */
+                                 RTCCollideFunc callback, /*!< callback invoked for colliding primitive pairs */
+                                 void* userPtr);          /*!< user pointer passed to callback */
+
     struct Intersector1
     {
       Intersector1 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), name(nullptr) {}
+      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), pointQuery(nullptr), name(nullptr) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, const char* name)
-      : intersect(intersect), occluded(occluded), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(nullptr), name(name) {}
+
+      Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, const char* name)
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), name(name) {}
 
       operator bool() const { return name; }
 
@@ -148,6 +167,7 @@ namespace embree
       static const char* type;
       IntersectFunc intersect;
       OccludedFunc occluded;  
+      PointQueryFunc pointQuery;
       const char* name;
     };
     
@@ -219,16 +239,36 @@ namespace embree
       const char* name;
     };
    
+    struct Collider
+    {
+      Collider (ErrorFunc error = nullptr)
+      : collide((CollideFunc)error), name(nullptr) {}
+
+      Collider (CollideFunc collide, const char* name)
+      : collide(collide), name(name) {}
+
+      operator bool() const { return name; }
+
+    public:
+      static const char* type;
+      CollideFunc collide;
+      const char* name;
+    };
+   
     struct Intersectors 
     {
       Intersectors() 
-        : ptr(nullptr), leafIntersector(nullptr), intersector1(nullptr), intersector4(nullptr), intersector8(nullptr), intersector16(nullptr), intersectorN(nullptr) {}
+        : ptr(nullptr), leafIntersector(nullptr), collider(nullptr), intersector1(nullptr), intersector4(nullptr), intersector8(nullptr), intersector16(nullptr), intersectorN(nullptr) {}
 
       Intersectors (ErrorFunc error) 
-      : ptr(nullptr), leafIntersector(nullptr), intersector1(error), intersector4(error), intersector8(error), intersector16(error), intersectorN(error) {}
+      : ptr(nullptr), leafIntersector(nullptr), collider(error), intersector1(error), intersector4(error), intersector8(error), intersector16(error), intersectorN(error) {}
 
       void print(size_t ident) 
       {
+        if (collider.name) {
+          for (size_t i=0; i<ident; i++) std::cout << " ";
+          std::cout << "collider      = " << collider.name << std::endl;
+        }
         if (intersector1.name) {
           for (size_t i=0; i<ident; i++) std::cout << " ";
           std::cout << "intersector1  = " << intersector1.name << std::endl;
@@ -271,6 +311,18 @@ namespace embree
 	}        
       }
 
+      /*! Reports all pairs of overlapping primitives of this and some other accel. */
+      __forceinline void collide (Intersectors* This1, RTCCollideFunc callback, void* userPtr) {
+        assert(collider.collide);
+        collider.collide(this,This1,callback,userPtr);
+      }
+
+      /*! Performs a point query for the scene, returns true if the query radius got changed. */
+      __forceinline bool pointQuery (PointQuery* query, PointQueryContext* context) {
+        if (!intersector1.pointQuery) return false;
+        return intersector1.pointQuery(this,query,context);
+      }
+
       /*! Intersects a single ray with the scene. */
       __forceinline void intersect (RTCRayHit& ray, IntersectContext* context) {
         assert(intersector1.intersect);
@@ -403,6 +455,7 @@ namespace embree
     public:
       AccelData* ptr;
       void* leafIntersector;
+      Collider collider;
       Intersector1 intersector1;
       Intersector4 intersector4;
       Intersector4 intersector4_filter;
@@ -441,11 +494,18 @@ namespace embree
     Intersectors intersectors;
   };
 
-#define DEFINE_INTERSECTOR1(symbol,intersector)                              \
-  Accel::Intersector1 symbol() {                                             \
-    return Accel::Intersector1((Accel::IntersectFunc)intersector::intersect, \
-                               (Accel::OccludedFunc )intersector::occluded,  \
-                               TOSTRING(isa) "::" TOSTRING(symbol));         \
+#define DEFINE_COLLIDER(symbol,collider)                                      \
+  Accel::Collider symbol() {                                                  \
+    return Accel::Collider((Accel::CollideFunc)collider::collide,             \
+                           TOSTRING(isa) "::" TOSTRING(symbol));              \
+  }
+
+#define DEFINE_INTERSECTOR1(symbol,intersector)                               \
+  Accel::Intersector1 symbol() {                                              \
+    return Accel::Intersector1((Accel::IntersectFunc )intersector::intersect, \
+                               (Accel::OccludedFunc  )intersector::occluded,  \
+                               (Accel::PointQueryFunc)intersector::pointQuery,\
+                               TOSTRING(isa) "::" TOSTRING(symbol));          \
   }
   
 #define DEFINE_INTERSECTOR4(symbol,intersector)                               \
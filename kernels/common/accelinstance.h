@@ -47,6 +47,10 @@ namespace embree
       if (builder) builder->clear();
     }
 
+    void replicate() {
+      if (accel) accel->replicate();
+    }
+
   private:
     std::unique_ptr<AccelData> accel;
     std::unique_ptr<Builder> builder;
@@ -45,6 +45,14 @@ namespace embree
     static void occluded16 (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context);
     static void occludedN (Accel::Intersectors* This, RTCRayN** ray, const size_t N, IntersectContext* context);
 
+  public:
+    static bool pointQuery (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+
+  public:
+    void build () { accels_build(); }
+    void clear () { accels_clear(); }
+    void replicate () { accels_replicate(); }
+
   public:
     void accels_print(size_t ident);
     void accels_immutable();
@@ -52,6 +60,7 @@ namespace embree
     void accels_select(bool filter);
     void accels_deleteGeometry(size_t geomID);
     void accels_clear ();
+    void accels_replicate ();
 
   public:
     std::vector<Accel*> accels;
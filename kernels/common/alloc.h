@@ -41,6 +41,12 @@ namespace embree
     struct ThreadLocal2;
     enum AllocationType { ALIGNED_MALLOC, OS_MALLOC, SHARED, ANY_TYPE };
 
+    /*! NUMA placement of blocks, values >= 0 identify the NUMA node a block is bound to */
+    static const int NUMA_NONE = -1;         //!< pages placed by the OS on first touch
+    static const int NUMA_INTERLEAVED = -2;  //!< pages interleaved over all NUMA nodes
+    static const int NUMA_BOUND = -3;        //!< selects blocks bound to any NUMA node in statistics
+    static const int NUMA_ANY = -4;          //!< selects all blocks in statistics
+
     /*! Per thread structure holding the current memory block. */
     struct __aligned(64) ThreadLocal
     {
@@ -183,7 +189,7 @@ namespace embree
     FastAllocator (Device* device, bool osAllocation) 
       : device(device), slotMask(0), usedBlocks(nullptr), freeBlocks(nullptr), use_single_mode(false), defaultBlockSize(PAGE_SIZE), estimatedSize(0),
         growSize(PAGE_SIZE), maxGrowSize(maxAllocationSize), log2_grow_size_scale(0), bytesUsed(0), bytesFree(0), bytesWasted(0), atype(osAllocation ? OS_MALLOC : ALIGNED_MALLOC),
-        primrefarray(device,0)
+        numa_node(NUMA_NONE), primrefarray(device,0)
     {
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
       {
@@ -222,6 +228,25 @@ namespace embree
       atype = flag ? OS_MALLOC : ALIGNED_MALLOC;
     }
 
+    /*! binds all further blocks to the specified NUMA node, overriding the NUMA policy of the device */
+    void setNumaNode(int node) {
+      numa_node = node;
+    }
+
+    /*! returns the NUMA placement for blocks created by the calling thread */
+    int getNumaPlacement() const
+    {
+      if (numa_node >= 0) return numa_node;
+      if (!device || getNumberOfNumaNodes() <= 1) return NUMA_NONE;
+      
+      switch (device->alloc_numa_policy) {
+      case State::NUMA_POLICY_LOCAL     : return getCurrentNumaNode();
+      case State::NUMA_POLICY_INTERLEAVE: return NUMA_INTERLEAVED;
+      case State::NUMA_POLICY_REPLICATE : return getCurrentNumaNode(); // replicas select their node through setNumaNode
+      default                           : return NUMA_NONE;
+      }
+    }
+
   private:
 
     /*! returns both fast thread local allocators */
@@ -405,7 +430,7 @@ namespace embree
       slotMask = MAX_THREAD_USED_BLOCK_SLOTS-1; // FIXME: remove
       if (usedBlocks.load() || freeBlocks.load()) { reset(); return; }
       if (bytesReserve == 0) bytesReserve = bytesAllocate;
-      freeBlocks = Block::create(device,bytesAllocate,bytesReserve,nullptr,atype);
+      freeBlocks = Block::create(device,bytesAllocate,bytesReserve,nullptr,atype,getNumaPlacement());
       estimatedSize = bytesEstimate;
       initGrowSizeAndNumSlots(bytesEstimate,true);
     }
@@ -514,7 +539,7 @@ namespace embree
             const size_t alignedBytes = (bytes+(align-1)) & ~(align-1);
             const size_t allocSize = max(min(growSize,maxGrowSize),alignedBytes);
             assert(allocSize >= bytes);
-            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot],atype); // FIXME: a large allocation might throw away a block here!
+            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot],atype,getNumaPlacement()); // FIXME: a large allocation might throw away a block here!
             // FIXME: a direct allocation should allocate inside the block here, and not in the next loop! a different thread could do some allocation and make the large allocation fail.
           }
           continue;
@@ -534,7 +559,7 @@ namespace embree
 	      freeBlocks = nextFreeBlock;
 	    } else {
               const size_t allocSize = min(growSize*incGrowSizeScale(),maxGrowSize);
-	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,usedBlocks,atype); // FIXME: a large allocation should get delivered directly, like above!
+	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,usedBlocks,atype,getNumaPlacement()); // FIXME: a large allocation should get delivered directly, like above!
 	    }
           }
         }
@@ -568,16 +593,16 @@ namespace embree
       Statistics (size_t bytesUsed, size_t bytesFree, size_t bytesWasted)
       : bytesUsed(bytesUsed), bytesFree(bytesFree), bytesWasted(bytesWasted) {}
 
-      Statistics (FastAllocator* alloc, AllocationType atype, bool huge_pages = false)
+      Statistics (FastAllocator* alloc, AllocationType atype, bool huge_pages = false, int numa = NUMA_ANY)
       : bytesUsed(0), bytesFree(0), bytesWasted(0)
       {
         Block* usedBlocks = alloc->usedBlocks.load();
         Block* freeBlocks = alloc->freeBlocks.load();
-        if (usedBlocks) bytesUsed += usedBlocks->getUsedBytes(atype,huge_pages);
-        if (freeBlocks) bytesFree += freeBlocks->getAllocatedBytes(atype,huge_pages);
-        if (usedBlocks) bytesFree += usedBlocks->getFreeBytes(atype,huge_pages);
-        if (freeBlocks) bytesWasted += freeBlocks->getWastedBytes(atype,huge_pages);
-        if (usedBlocks) bytesWasted += usedBlocks->getWastedBytes(atype,huge_pages);
+        if (usedBlocks) bytesUsed += usedBlocks->getUsedBytes(atype,huge_pages,numa);
+        if (freeBlocks) bytesFree += freeBlocks->getAllocatedBytes(atype,huge_pages,numa);
+        if (usedBlocks) bytesFree += usedBlocks->getFreeBytes(atype,huge_pages,numa);
+        if (freeBlocks) bytesWasted += freeBlocks->getWastedBytes(atype,huge_pages,numa);
+        if (usedBlocks) bytesWasted += usedBlocks->getWastedBytes(atype,huge_pages,numa);
       }
 
       std::string str(size_t numPrimitives)
@@ -632,7 +657,9 @@ namespace embree
         stat_malloc(alloc,ALIGNED_MALLOC),
         stat_4K(alloc,OS_MALLOC,false),
         stat_2M(alloc,OS_MALLOC,true),
-        stat_shared(alloc,SHARED) {}
+        stat_shared(alloc,SHARED),
+        stat_numa_bound(alloc,ANY_TYPE,false,NUMA_BOUND),
+        stat_numa_interleaved(alloc,ANY_TYPE,false,NUMA_INTERLEAVED) {}
 
       AllStatistics (size_t bytesUsed,
                      size_t bytesFree,
@@ -641,7 +668,9 @@ namespace embree
                      Statistics stat_malloc,
                      Statistics stat_4K,
                      Statistics stat_2M,
-                     Statistics stat_shared)
+                     Statistics stat_shared,
+                     Statistics stat_numa_bound,
+                     Statistics stat_numa_interleaved)
 
       : bytesUsed(bytesUsed),
         bytesFree(bytesFree),
@@ -650,7 +679,9 @@ namespace embree
         stat_malloc(stat_malloc),
         stat_4K(stat_4K),
         stat_2M(stat_2M),
-        stat_shared(stat_shared) {}
+        stat_shared(stat_shared),
+        stat_numa_bound(stat_numa_bound),
+        stat_numa_interleaved(stat_numa_interleaved) {}
 
       friend AllStatistics operator+ (const AllStatistics& a, const AllStatistics& b)
       {
@@ -661,7 +692,9 @@ namespace embree
                              a.stat_malloc + b.stat_malloc,
                              a.stat_4K + b.stat_4K,
                              a.stat_2M + b.stat_2M,
-                             a.stat_shared + b.stat_shared);
+                             a.stat_shared + b.stat_shared,
+                             a.stat_numa_bound + b.stat_numa_bound,
+                             a.stat_numa_interleaved + b.stat_numa_interleaved);
       }
 
       void print(size_t numPrimitives)
@@ -689,6 +722,8 @@ namespace embree
         std::cout << "  2M    : " << stat_2M.str(numPrimitives) << std::endl;
         std::cout << "  malloc: " << stat_malloc.str(numPrimitives) << std::endl;
         std::cout << "  shared: " << stat_shared.str(numPrimitives) << std::endl;
+        std::cout << "  node  : " << stat_numa_bound.str(numPrimitives) << std::endl;
+        std::cout << "  interl: " << stat_numa_interleaved.str(numPrimitives) << std::endl;
       }
 
     private:
@@ -700,6 +735,8 @@ namespace embree
       Statistics stat_4K;
       Statistics stat_2M;
       Statistics stat_shared;
+      Statistics stat_numa_bound;
+      Statistics stat_numa_interleaved;
     };
 
     void print_blocks()
@@ -719,7 +756,7 @@ namespace embree
 
     struct Block
     {
-      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype)
+      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype, int numa = NUMA_NONE)
       {
         /* We avoid using os_malloc for small blocks as this could
          * cause a risk of fragmenting the virtual address space and
@@ -755,21 +792,24 @@ namespace embree
             os_advise((void*)(ptr_aligned_begin + 1*PAGE_SIZE_2M),PAGE_SIZE_2M);
             os_advise((void*)(ptr_aligned_begin + 2*PAGE_SIZE_2M),PAGE_SIZE_2M); // may fail if no memory mapped after block
 
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
+            numa = place(ptr,bytesAllocate,numa);
+            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment,false,numa);
           }
           else
           {
             const size_t alignment = maxAlignment;
             if (device) device->memoryMonitor(bytesAllocate+alignment,false);
             ptr = alignedMalloc(bytesAllocate,alignment);
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
+            numa = place(ptr,bytesAllocate,numa);
+            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment,false,numa);
           }
         }
         else if (atype == OS_MALLOC)
         {
           if (device) device->memoryMonitor(bytesAllocate,false);
           bool huge_pages; ptr = os_malloc(bytesReserve,huge_pages);
-          return new (ptr) Block(OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages);
+          numa = place(ptr,bytesReserve,numa);
+          return new (ptr) Block(OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages,numa);
         }
         else
           assert(false);
@@ -777,8 +817,21 @@ namespace embree
         return NULL;
       }
 
-      Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false)
-      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), huge_pages(huge_pages)
+      /*! places the untouched pages of a new block on NUMA nodes, returns the placement achieved */
+      static int place(void* ptr, size_t bytes, int numa)
+      {
+        /* small blocks are not placed to not fragment the memory map into many regions */
+        if (numa == NUMA_NONE || bytes < maxAllocationSize)
+          return NUMA_NONE;
+
+        if (numa == NUMA_INTERLEAVED)
+          return os_numa_interleave(ptr,bytes) ? NUMA_INTERLEAVED : NUMA_NONE;
+        else
+          return os_numa_bind(ptr,bytes,numa) ? numa : NUMA_NONE;
+      }
+
+      Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false, int numa_node = NUMA_NONE)
+      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), numa_node(numa_node), huge_pages(huge_pages)
       {
         assert((((size_t)&data[0]) & (maxAlignment-1)) == 0);
       }
@@ -878,37 +931,45 @@ namespace embree
         else                           return atype_i == atype;
       }
 
-      size_t getUsedBytes(AllocationType atype, bool huge_pages = false) const {
+      bool hasType(AllocationType atype_i, bool huge_pages_i, int numa_i) const
+      {
+        if (!hasType(atype_i,huge_pages_i)) return false;
+        if      (numa_i == NUMA_ANY  ) return true;
+        else if (numa_i == NUMA_BOUND) return numa_node >= 0;
+        else                           return numa_i == numa_node;
+      }
+
+      size_t getUsedBytes(AllocationType atype, bool huge_pages = false, int numa = NUMA_ANY) const {
         size_t bytes = 0;
         for (const Block* block = this; block; block = block->next) {
-          if (!block->hasType(atype,huge_pages)) continue;
+          if (!block->hasType(atype,huge_pages,numa)) continue;
           bytes += block->getBlockUsedBytes();
         }
         return bytes;
       }
 
-      size_t getFreeBytes(AllocationType atype, bool huge_pages = false) const {
+      size_t getFreeBytes(AllocationType atype, bool huge_pages = false, int numa = NUMA_ANY) const {
         size_t bytes = 0;
         for (const Block* block = this; block; block = block->next) {
-          if (!block->hasType(atype,huge_pages)) continue;
+          if (!block->hasType(atype,huge_pages,numa)) continue;
           bytes += block->getBlockFreeBytes();
         }
         return bytes;
       }
 
-      size_t getWastedBytes(AllocationType atype, bool huge_pages = false) const {
+      size_t getWastedBytes(AllocationType atype, bool huge_pages = false, int numa = NUMA_ANY) const {
         size_t bytes = 0;
         for (const Block* block = this; block; block = block->next) {
-          if (!block->hasType(atype,huge_pages)) continue;
+          if (!block->hasType(atype,huge_pages,numa)) continue;
           bytes += block->getBlockWastedBytes();
         }
         return bytes;
       }
 
-      size_t getAllocatedBytes(AllocationType atype, bool huge_pages = false) const {
+      size_t getAllocatedBytes(AllocationType atype, bool huge_pages = false, int numa = NUMA_ANY) const {
         size_t bytes = 0;
         for (const Block* block = this; block; block = block->next) {
-          if (!block->hasType(atype,huge_pages)) continue;
+          if (!block->hasType(atype,huge_pages,numa)) continue;
           bytes += block->getBlockAllocatedBytes();
         }
         return bytes;
@@ -926,6 +987,8 @@ namespace embree
         else if (atype == OS_MALLOC) std::cout << "O";
         else if (atype == SHARED) std::cout << "S";
         if (huge_pages) std::cout << "H";
+        if (numa_node == NUMA_INTERLEAVED) std::cout << "I";
+        else if (numa_node >= 0) std::cout << "N" << numa_node;
         size_t bytesUsed = getBlockUsedBytes();
         size_t bytesFree = getBlockFreeBytes();
         size_t bytesWasted = getBlockWastedBytes();
@@ -939,8 +1002,9 @@ namespace embree
       Block* next;               //!< pointer to next block in list
       size_t wasted;             //!< amount of memory wasted through block alignment
       AllocationType atype;      //!< allocation mode of the block
+      int numa_node;             //!< NUMA node the block is bound to, or NUMA_NONE or NUMA_INTERLEAVED
       bool huge_pages;           //!< whether the block uses huge pages
-      char align[maxAlignment-5*sizeof(size_t)-sizeof(AllocationType)-sizeof(bool)]; //!< align data to maxAlignment
+      char align[maxAlignment-5*sizeof(size_t)-sizeof(AllocationType)-sizeof(int)-sizeof(bool)]; //!< align data to maxAlignment
       char data[1];              //!< here starts memory to use for allocations
     };
 
@@ -970,6 +1034,7 @@ namespace embree
     SpinLock thread_local_allocators_lock;
     std::vector<ThreadLocal2*> thread_local_allocators;
     AllocationType atype;
+    int numa_node;                     //!< NUMA node all blocks get bound to, NUMA_NONE to use the policy of the device
     mvector<PrimRef> primrefarray;     //!< primrefarray used to allocate nodes
   };
 }
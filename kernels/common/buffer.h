@@ -145,7 +145,7 @@ namespace embree
   public:
     /*! Buffer construction */
     RawBufferView()
-      : ptr_ofs(nullptr), stride(0), num(0), format(RTC_FORMAT_UNDEFINED), modified(true), userData(0) {}
+      : ptr_ofs(nullptr), stride(0), num(0), format(RTC_FORMAT_UNDEFINED), modified(true), modifiedBegin(0), modifiedEnd(size_t(-1)), userData(0) {}
 
   public:
     /*! sets the buffer view */
@@ -158,7 +158,7 @@ namespace embree
       stride = stride_in;
       num = num_in;
       format = format_in;
-      modified = true;
+      setModified(true);
       buffer = buffer_in;
     }
 
@@ -199,6 +199,21 @@ namespace embree
     /*! mark buffer as modified or unmodified */
     __forceinline void setModified(bool b) {
       modified = b;
+      modifiedBegin = 0;
+      modifiedEnd = b ? size_t(-1) : 0;
+    }
+
+    /*! mark a range of elements of the buffer as modified */
+    __forceinline void setModified(size_t begin, size_t end)
+    {
+      if (!modified) {
+        modifiedBegin = begin;
+        modifiedEnd = end;
+      } else {
+        modifiedBegin = min(modifiedBegin,begin);
+        modifiedEnd = max(modifiedEnd,end);
+      }
+      modified = true;
     }
 
     /*! mark buffer as modified or unmodified */
@@ -206,6 +221,11 @@ namespace embree
       return modified;
     }
 
+    /*! returns the range of modified elements, the range is empty if the buffer is not modified */
+    __forceinline range<size_t> getModifiedRange() const {
+      return range<size_t>(modifiedBegin,min(modifiedEnd,num));
+    }
+
     /*! returns true of the buffer is not empty */
     __forceinline operator bool() const { 
       return ptr_ofs; 
@@ -224,6 +244,8 @@ namespace embree
     size_t num;         //!< number of elements in the buffer
     RTCFormat format;   //!< format of the buffer
     bool modified;      //!< true if the buffer got modified
+    size_t modifiedBegin; //!< first modified element
+    size_t modifiedEnd;   //!< one past the last modified element
     int userData;       //!< special data
     Ref<Buffer> buffer; //!< reference to the parent buffer
   };
@@ -311,6 +311,18 @@ namespace embree
       maxCacheSize = max(maxCacheSize, (*i).second);
     return maxCacheSize;
   }
+
+  size_t getMaxCachePartitions()
+  {
+    /* use the partitioning of the device that requested the largest cache */
+    size_t maxCacheSize = 0, partitions = 0;
+    for (std::map<Device*,size_t>::iterator i=g_cache_size_map.begin(); i!= g_cache_size_map.end(); i++) {
+      if ((*i).second <= maxCacheSize) continue;
+      maxCacheSize = (*i).second;
+      partitions = (*i).first->tessellation_cache_partitions;
+    }
+    return partitions;
+  }
  
   void Device::setCacheSize(size_t bytes) 
   {
@@ -320,7 +332,7 @@ namespace embree
     else            g_cache_size_map[this] = bytes;
     
     size_t maxCacheSize = getMaxCacheSize();
-    resizeTessellationCache(maxCacheSize);
+    resizeTessellationCache(maxCacheSize,getMaxCachePartitions());
 #endif
   }
 
@@ -370,6 +382,44 @@ namespace embree
     case 1000003: debug_int3 = val; return;
     }
 
+    switch (prop)
+    {
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE:
+      if (val < 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid tessellation cache size");
+      State::tessellation_cache_size = val;
+      setCacheSize(State::tessellation_cache_size);
+      return;
+
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES:
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+      SharedLazyTessellationCache::sharedLazyTessellationCache.clearStats();
+#endif
+      return;
+
+    case RTC_DEVICE_PROPERTY_RAY_STATISTICS_ENABLED:
+      Stat::enable(val != 0);
+      return;
+
+    case RTC_DEVICE_PROPERTY_INTERSECT_RAYS:
+    case RTC_DEVICE_PROPERTY_INTERSECT_NODES:
+    case RTC_DEVICE_PROPERTY_INTERSECT_LEAVES:
+    case RTC_DEVICE_PROPERTY_INTERSECT_PRIMITIVES:
+    case RTC_DEVICE_PROPERTY_INTERSECT_FILTER_CALLS:
+    case RTC_DEVICE_PROPERTY_INTERSECT_INSTANCES:
+    case RTC_DEVICE_PROPERTY_OCCLUDED_RAYS:
+    case RTC_DEVICE_PROPERTY_OCCLUDED_NODES:
+    case RTC_DEVICE_PROPERTY_OCCLUDED_LEAVES:
+    case RTC_DEVICE_PROPERTY_OCCLUDED_PRIMITIVES:
+    case RTC_DEVICE_PROPERTY_OCCLUDED_FILTER_CALLS:
+    case RTC_DEVICE_PROPERTY_OCCLUDED_INSTANCES:
+      Stat::clearThreadCounters();
+      return;
+
+    default: break;
+    }
+
     throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown writable property");
   }
 
@@ -505,6 +555,34 @@ namespace embree
     case RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED: return 1;
 #endif
 
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE      : return SharedLazyTessellationCache::sharedLazyTessellationCache.getSize();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_BYTES_USED: return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumUsedBytes();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS      : return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumHits();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES    : return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumMisses();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES   : return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumFlushes();
+#else
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE      : return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_BYTES_USED: return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS      : return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES    : return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES   : return 0;
+#endif
+
+    case RTC_DEVICE_PROPERTY_RAY_STATISTICS_ENABLED: return Stat::enabled;
+    case RTC_DEVICE_PROPERTY_INTERSECT_RAYS        : return Stat::sumThreadCounters().normal.travs;
+    case RTC_DEVICE_PROPERTY_INTERSECT_NODES       : return Stat::sumThreadCounters().normal.trav_nodes;
+    case RTC_DEVICE_PROPERTY_INTERSECT_LEAVES      : return Stat::sumThreadCounters().normal.trav_leaves;
+    case RTC_DEVICE_PROPERTY_INTERSECT_PRIMITIVES  : return Stat::sumThreadCounters().normal.trav_prims;
+    case RTC_DEVICE_PROPERTY_INTERSECT_FILTER_CALLS: return Stat::sumThreadCounters().normal.trav_filters;
+    case RTC_DEVICE_PROPERTY_INTERSECT_INSTANCES   : return Stat::sumThreadCounters().normal.trav_xfm_nodes;
+    case RTC_DEVICE_PROPERTY_OCCLUDED_RAYS         : return Stat::sumThreadCounters().shadow.travs;
+    case RTC_DEVICE_PROPERTY_OCCLUDED_NODES        : return Stat::sumThreadCounters().shadow.trav_nodes;
+    case RTC_DEVICE_PROPERTY_OCCLUDED_LEAVES       : return Stat::sumThreadCounters().shadow.trav_leaves;
+    case RTC_DEVICE_PROPERTY_OCCLUDED_PRIMITIVES   : return Stat::sumThreadCounters().shadow.trav_prims;
+    case RTC_DEVICE_PROPERTY_OCCLUDED_FILTER_CALLS : return Stat::sumThreadCounters().shadow.trav_filters;
+    case RTC_DEVICE_PROPERTY_OCCLUDED_INSTANCES    : return Stat::sumThreadCounters().shadow.trav_xfm_nodes;
+
     default: throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown readable property"); break;
     };
   }
@@ -59,7 +59,7 @@ namespace embree
       state(MODIFIED),
       numPrimitivesChanged(false),
       enabled(true),
-      intersectionFilterN(nullptr), occlusionFilterN(nullptr)
+      intersectionFilterN(nullptr), occlusionFilterN(nullptr), pointQueryFunc(nullptr)
   {
     device->refInc();
   }
@@ -223,6 +223,14 @@ namespace embree
     occlusionFilterN = filter;
   }
 
+  void Geometry::setPointQueryFunction (RTCPointQueryFunction func) 
+  {
+    if (!(getTypeMask() & (MTY_TRIANGLE_MESH | MTY_QUAD_MESH | MTY_USER_GEOMETRY | MTY_GRID_MESH)))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"point query functions not supported for this geometry"); 
+
+    pointQueryFunc = func;
+  }
+
   void Geometry::interpolateN(const RTCInterpolateNArguments* const args)
   {
     const void* valid_i = args->valid;
@@ -231,6 +231,11 @@ namespace embree
     virtual void updateBuffer(RTCBufferType type, unsigned int slot) {
       update(); // update everything for geometries not supporting this call
     }
+
+    /*! Update range of items of geometry buffer. */
+    virtual void updateBuffer(RTCBufferType type, unsigned int slot, unsigned int begin, unsigned int count) {
+      updateBuffer(type,slot); // update entire buffer for geometries not supporting ranged updates
+    }
     
     /*! Disable geometry. */
     virtual void disable();
@@ -331,6 +336,9 @@ namespace embree
     /*! Set occlusion filter function for ray packets of size N. */
     virtual void setOcclusionFilterFunctionN (RTCFilterFunctionN filterN);
 
+    /*! Set point query function. */
+    virtual void setPointQueryFunction (RTCPointQueryFunction func);
+
     /*! for instances only */
   public:
 
@@ -453,5 +461,6 @@ namespace embree
        
     RTCFilterFunctionN intersectionFilterN;
     RTCFilterFunctionN occlusionFilterN;
+    RTCPointQueryFunction pointQueryFunc;
   };
 }
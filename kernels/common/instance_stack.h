@@ -0,0 +1,99 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Helpers to manage the stack of instance IDs inside the
+   *  intersection context. The stack size is only stored explicitly
+   *  when more than one instance level is supported, otherwise an
+   *  invalid ID marks the empty stack. */
+  namespace instance_id_stack
+  {
+    static_assert(RTC_MAX_INSTANCE_LEVEL_COUNT > 0, "RTC_MAX_INSTANCE_LEVEL_COUNT must be greater than 0.");
+
+    /*! returns the number of instances currently on the stack */
+    __forceinline unsigned int size(const RTCIntersectContext* context)
+    {
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      return context->instStackSize;
+#else
+      return context->instID[0] != RTC_INVALID_GEOMETRY_ID;
+#endif
+    }
+
+    /*! pushes an instance ID, returns false if the maximal number of instance levels is exceeded */
+    __forceinline bool push(RTCIntersectContext* context, unsigned int instanceId)
+    {
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      if (unlikely(context->instStackSize >= RTC_MAX_INSTANCE_LEVEL_COUNT))
+        return false;
+      context->instID[context->instStackSize++] = instanceId;
+#else
+      if (unlikely(context->instID[0] != RTC_INVALID_GEOMETRY_ID))
+        return false;
+      context->instID[0] = instanceId;
+#endif
+      return true;
+    }
+
+    /*! pops the topmost instance ID */
+    __forceinline void pop(RTCIntersectContext* context)
+    {
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      assert(context->instStackSize > 0);
+      context->instID[--context->instStackSize] = RTC_INVALID_GEOMETRY_ID;
+#else
+      assert(context->instID[0] != RTC_INVALID_GEOMETRY_ID);
+      context->instID[0] = RTC_INVALID_GEOMETRY_ID;
+#endif
+    }
+
+    /*! copies the instance stack to some instance ID array, unused levels are set to invalid */
+    __forceinline void copy(const unsigned int* src, unsigned int* dst)
+    {
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        dst[l] = src[l];
+    }
+
+    /*! copies the instance stack into lane k of some SIMD instance ID array */
+    template<typename VUInt>
+    __forceinline void copy(const unsigned int* src, VUInt* dst, size_t k)
+    {
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        dst[l][k] = src[l];
+    }
+
+    /*! copies lane k of some SIMD instance ID array into an instance ID array */
+    template<typename VUInt>
+    __forceinline void copy(const VUInt* src, unsigned int* dst, size_t k)
+    {
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        dst[l] = src[l][k];
+    }
+
+    /*! stores the instance stack into the active lanes of some SIMD instance ID array */
+    template<typename VBool, typename VUInt>
+    __forceinline void store(const VBool& valid, const unsigned int* src, VUInt* dst)
+    {
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        VUInt::store(valid,&dst[l],VUInt(src[l]));
+    }
+  }
+}
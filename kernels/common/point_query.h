@@ -0,0 +1,97 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include "scene.h"
+
+namespace embree
+{
+  /* Point query structure for closest point query, layout compatible to RTCPointQuery */
+  struct __aligned(16) PointQuery
+  {
+    Vec3f p;      //!< location of the query point
+    float time;   //!< time of the point query
+    float radius; //!< radius of the point query
+  };
+
+  struct PointQueryContext
+  {
+  public:
+    __forceinline PointQueryContext(Scene* scene, PointQuery* query_ws, RTCPointQueryContext* user_context, RTCPointQueryFunction func, void* userPtr)
+      : scene(scene), query_ws(query_ws), user(user_context), func(func), userPtr(userPtr), similarityScale(1.0f), queryRadiusScale(1.0f) {}
+
+    /*! Invokes the point query callback for some primitive. For
+     *  similarity transformations the callback gets the query in
+     *  instance space, otherwise the callback gets the world space
+     *  query. Returns true if the query radius got changed. */
+    __forceinline bool callback(PointQuery* query, unsigned int geomID, unsigned int primID)
+    {
+      const Geometry* geom = scene->get(geomID);
+      RTCPointQueryFunction f = geom->pointQueryFunc ? geom->pointQueryFunc : func;
+      if (!f) return false;
+
+      RTCPointQueryFunctionArguments args;
+      args.userPtr = userPtr;
+      args.primID = primID;
+      args.geomID = geomID;
+      args.context = user;
+
+      if (similarityScale > 0.0f)
+      {
+        args.query = (RTCPointQuery*)query;
+        args.similarityScale = similarityScale;
+        if (!f(&args)) return false;
+        query_ws->radius = query->radius / similarityScale;
+        return true;
+      }
+      else
+      {
+        args.query = (RTCPointQuery*)query_ws;
+        args.similarityScale = 0.0f;
+        if (!f(&args)) return false;
+        query->radius = query_ws->radius * queryRadiusScale;
+        return true;
+      }
+    }
+
+  public:
+    Scene* scene;                //!< scene the query currently traverses
+    PointQuery* query_ws;        //!< world space point query
+    RTCPointQueryContext* user;  //!< user context holding the instance stack
+    RTCPointQueryFunction func;  //!< point query callback passed to rtcPointQuery
+    void* userPtr;               //!< user pointer passed to the callbacks
+    float similarityScale;       //!< scale of the world to instance similarity transform, 0 for general transforms
+    float queryRadiusScale;      //!< conservative scale from world space query radius to instance space radius
+  };
+
+  /*! Invokes the point query callback for all valid primitives of some leaf block. */
+  template<typename Primitive>
+  struct PrimitivePointQuery1
+  {
+    static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+    {
+      bool changed = false;
+      for (size_t i=0; i<Primitive::max_size(); i++)
+      {
+        if (!prim.valid(i)) continue;
+        changed |= context->callback(query,prim.geomID(i),prim.primID(i));
+      }
+      return changed;
+    }
+  };
+}
@@ -17,12 +17,14 @@
 #pragma once
 
 #include "default.h"
+#include "instance_stack.h"
 
 // FIXME: if ray gets seperated into ray* and hit, uload4 needs to be adjusted
 
 namespace embree
 {
   static const size_t MAX_INTERNAL_STREAM_SIZE = 32;
+  static const size_t MAX_SORTED_STREAM_SIZE = 4096; // maximal number of rays sorted together in sorted stream mode
 
   /* Ray structure for K rays */
   template<int K>
@@ -216,7 +218,7 @@ namespace embree
     vfloat<K> v;    // barycentric v coordinate of hit
     vuint<K> primID; // primitive ID
     vuint<K> geomID; // geometry ID
-    vuint<K> instID; // instance ID
+    vuint<K> instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID
   };
 
 #if defined(__AVX512F__)
@@ -393,7 +395,7 @@ namespace embree
     float v;             // barycentric v coordinate of hit
     unsigned int primID; // primitive ID
     unsigned int geomID; // geometry ID
-    unsigned int instID; // instance ID
+    unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID
   };
 
   /* Converts ray packet to single rays */
@@ -418,7 +420,8 @@ namespace embree
       ray[i].tfar  = tfar[i]; ray[i].mask = mask[i]; ray[i].id = id[i]; ray[i].flags = flags[i];
       ray[i].Ng.x = Ng.x[i]; ray[i].Ng.y = Ng.y[i]; ray[i].Ng.z = Ng.z[i];
       ray[i].u = u[i]; ray[i].v = v[i];
-      ray[i].primID = primID[i]; ray[i].geomID = geomID[i]; ray[i].instID = instID[i];
+      ray[i].primID = primID[i]; ray[i].geomID = geomID[i];
+      instance_id_stack::copy(instID,ray[i].instID,i);
     }
   }
 
@@ -439,7 +442,8 @@ namespace embree
     ray.mask = mask[i];  ray.id = id[i]; ray.flags = flags[i];
     ray.Ng.x = Ng.x[i]; ray.Ng.y = Ng.y[i]; ray.Ng.z = Ng.z[i];
     ray.u = u[i]; ray.v = v[i];
-    ray.primID = primID[i]; ray.geomID = geomID[i]; ray.instID = instID[i];
+    ray.primID = primID[i]; ray.geomID = geomID[i];
+    instance_id_stack::copy(instID,ray.instID,i);
   }
 
   /* Converts single rays to ray packet */
@@ -464,7 +468,8 @@ namespace embree
       tfar[i] = ray[i].tfar; mask[i] = ray[i].mask; id[i] = ray[i].id; flags[i] = ray[i].flags;
       Ng.x[i] = ray[i].Ng.x; Ng.y[i] = ray[i].Ng.y; Ng.z[i] = ray[i].Ng.z;
       u[i] = ray[i].u; v[i] = ray[i].v;
-      primID[i] = ray[i].primID; geomID[i] = ray[i].geomID;  instID[i] = ray[i].instID;
+      primID[i] = ray[i].primID; geomID[i] = ray[i].geomID;
+      instance_id_stack::copy(ray[i].instID,instID,i);
     }
   }
 
@@ -485,7 +490,8 @@ namespace embree
     tfar[i] = ray.tfar; mask[i] = ray.mask; id[i] = ray.id; flags[i] = ray.flags;
     Ng.x[i] = ray.Ng.x; Ng.y[i] = ray.Ng.y; Ng.z[i] = ray.Ng.z;
     u[i] = ray.u; v[i] = ray.v;
-    primID[i] = ray.primID; geomID[i] = ray.geomID; instID[i] = ray.instID;
+    primID[i] = ray.primID; geomID[i] = ray.geomID;
+    instance_id_stack::copy(ray.instID,instID,i);
   }
 
   /* copies a ray packet element into another element*/
@@ -505,7 +511,9 @@ namespace embree
     tfar [dest] = tfar[source]; mask[dest] = mask[source]; id[dest] = id[source]; flags[dest] = flags[source];
     Ng.x[dest] = Ng.x[source]; Ng.y[dest] = Ng.y[source]; Ng.z[dest] = Ng.z[source];
     u[dest] = u[source]; v[dest] = v[source];
-    primID[dest] = primID[source]; geomID[dest] = geomID[source];  instID[dest] = instID[source];
+    primID[dest] = primID[source]; geomID[dest] = geomID[source];
+    for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      instID[l][dest] = instID[l][source];
   }
 
   /* Shortcuts */
@@ -575,7 +583,7 @@ namespace embree
                 << "  v = " << ray.v << std::endl
                 << "  primID = " << ray.primID <<  std::endl
                 << "  geomID = " << ray.geomID << std::endl
-                << "  instID = " << ray.instID << std::endl
+                << "  instID = " << ray.instID[0] << std::endl
                 << "}";
   }
 
@@ -611,7 +619,7 @@ namespace embree
 
     __forceinline unsigned int* primID(size_t offset = 0) { return (unsigned int*)&ptr[17*4*N+offset]; };   // primitive ID
     __forceinline unsigned int* geomID(size_t offset = 0) { return (unsigned int*)&ptr[18*4*N+offset]; };   // geometry ID
-    __forceinline unsigned int* instID(size_t offset = 0) { return (unsigned int*)&ptr[19*4*N+offset]; };   // instance ID
+    __forceinline unsigned int* instID(size_t level, size_t offset = 0) { return (unsigned int*)&ptr[19*4*N+level*4*N+offset]; }; // instance ID
 
     __forceinline Ray getRayByOffset(size_t offset)
     {
@@ -720,7 +728,8 @@ namespace embree
             {
               primID(offset)[k] = ray.primID[k];
               geomID(offset)[k] = ray.geomID[k];
-              instID(offset)[k] = ray.instID[k];
+              for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+                instID(l, offset)[k] = ray.instID[l][k];
             }
           }
         }
@@ -729,7 +738,8 @@ namespace embree
         {
           vuint<K>::storeu(valid, primID(offset), ray.primID);
           vuint<K>::storeu(valid, geomID(offset), ray.geomID);
-          vuint<K>::storeu(valid, instID(offset), ray.instID);
+          for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+            vuint<K>::storeu(valid, instID(l, offset), ray.instID[l]);
         }
       }
     }
@@ -830,7 +840,8 @@ namespace embree
         vfloat<K>::template scatter<1>(valid, v(), offset, ray.v);
         vuint<K>::template scatter<1>(valid, primID(), offset, ray.primID);
         vuint<K>::template scatter<1>(valid, geomID(), offset, ray.geomID);
-        vuint<K>::template scatter<1>(valid, instID(), offset, ray.instID);
+        for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          vuint<K>::template scatter<1>(valid, instID(l), offset, ray.instID[l]);
 #else
         size_t valid_bits = movemask(valid);
         while (valid_bits != 0)
@@ -847,7 +858,8 @@ namespace embree
           *v(ofs)      = ray.v[k];
           *primID(ofs) = ray.primID[k];
           *geomID(ofs) = ray.geomID[k];
-          *instID(ofs) = ray.instID[k];
+          for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+            *instID(l, ofs) = ray.instID[l][k];
         }
 #endif
       }
@@ -915,7 +927,8 @@ namespace embree
       v      = (float*)&t.v;
       primID = (unsigned int*)&t.primID;
       geomID = (unsigned int*)&t.geomID;
-      instID = (unsigned int*)&t.instID;
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        instID[l] = (unsigned int*)&t.instID[l];
     }
 
     __forceinline Ray getRayByOffset(size_t offset)
@@ -978,7 +991,8 @@ namespace embree
         *(float* __restrict__)((char*)v + offset) = ray.v;
         *(unsigned int* __restrict__)((char*)geomID + offset) = ray.geomID;
         *(unsigned int* __restrict__)((char*)primID + offset) = ray.primID;
-        if (likely(instID)) *(unsigned int* __restrict__)((char*)instID + offset) = ray.instID;
+        for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          if (likely(instID[l])) *(unsigned int* __restrict__)((char*)instID[l] + offset) = ray.instID[l];
       }
     }
 
@@ -1004,7 +1018,8 @@ namespace embree
         vfloat<K>::storeu(valid, (float* __restrict__)((char*)v + offset), ray.v);
         vuint<K>::storeu(valid, (unsigned int* __restrict__)((char*)primID + offset), ray.primID);
         vuint<K>::storeu(valid, (unsigned int* __restrict__)((char*)geomID + offset), ray.geomID);
-        if (likely(instID)) vuint<K>::storeu(valid, (unsigned int* __restrict__)((char*)instID + offset), ray.instID);
+        for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          if (likely(instID[l])) vuint<K>::storeu(valid, (unsigned int* __restrict__)((char*)instID[l] + offset), ray.instID[l]);
       }
     }
 
@@ -1113,7 +1128,8 @@ namespace embree
         vfloat<K>::template scatter<1>(valid, v, offset, ray.v);
         vuint<K>::template scatter<1>(valid, (unsigned int*)geomID, offset, ray.geomID);
         vuint<K>::template scatter<1>(valid, (unsigned int*)primID, offset, ray.primID);
-        if (likely(instID)) vuint<K>::template scatter<1>(valid, (unsigned int*)instID, offset, ray.instID);
+        for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          if (likely(instID[l])) vuint<K>::template scatter<1>(valid, (unsigned int*)instID[l], offset, ray.instID[l]);
 #else
         size_t valid_bits = movemask(valid);
         while (valid_bits != 0)
@@ -1130,7 +1146,8 @@ namespace embree
           *(float* __restrict__)((char*)v + ofs) = ray.v[k];
           *(unsigned int* __restrict__)((char*)primID + ofs) = ray.primID[k];
           *(unsigned int* __restrict__)((char*)geomID + ofs) = ray.geomID[k];
-          if (likely(instID)) *(unsigned int* __restrict__)((char*)instID + ofs) = ray.instID[k];
+          for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+            if (likely(instID[l])) *(unsigned int* __restrict__)((char*)instID[l] + ofs) = ray.instID[l][k];
         }
 #endif
       }
@@ -1185,7 +1202,7 @@ namespace embree
 
     unsigned int* __restrict__ primID; // primitive ID
     unsigned int* __restrict__ geomID; // geometry ID
-    unsigned int* __restrict__ instID; // instance ID (optional)
+    unsigned int* __restrict__ instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID (optional)
   };
 
 
@@ -1226,7 +1243,8 @@ namespace embree
         vfloat<K>::template scatter<1>(valid, &((RayHit*)ptr)->v, offset, ray.v);
         vuint<K>::template scatter<1>(valid, (unsigned int*)&((RayHit*)ptr)->primID, offset, ray.primID);
         vuint<K>::template scatter<1>(valid, (unsigned int*)&((RayHit*)ptr)->geomID, offset, ray.geomID);
-        vuint<K>::template scatter<1>(valid, (unsigned int*)&((RayHit*)ptr)->instID, offset, ray.instID);
+        for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          vuint<K>::template scatter<1>(valid, (unsigned int*)&((RayHit*)ptr)->instID[l], offset, ray.instID[l]);
 #else
         size_t valid_bits = movemask(valid);
         while (valid_bits != 0)
@@ -1241,7 +1259,7 @@ namespace embree
           ray_k->v      = ray.v[k];
           ray_k->primID = ray.primID[k];
           ray_k->geomID = ray.geomID[k];
-          ray_k->instID = ray.instID[k];
+          instance_id_stack::copy(ray.instID,ray_k->instID,k);
         }
 #endif
       }
@@ -1445,7 +1463,7 @@ namespace embree
           ray_k->v      = ray.v[k];
           ray_k->primID = ray.primID[k];
           ray_k->geomID = ray.geomID[k];
-          ray_k->instID = ray.instID[k];
+          instance_id_stack::copy(ray.instID,ray_k->instID,k);
         }
       }
     }
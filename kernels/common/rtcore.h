@@ -27,9 +27,10 @@ namespace embree
 /*! maximum number of index buffers for subdivision surfaces */
 #define RTC_MAX_INDEX_BUFFERS 65536
 
-  /*! decoding of intersection flags */
-  __forceinline bool isCoherent  (RTCIntersectContextFlags flags) { return (flags & RTC_INTERSECT_CONTEXT_FLAG_COHERENT) == RTC_INTERSECT_CONTEXT_FLAG_COHERENT; }
-  __forceinline bool isIncoherent(RTCIntersectContextFlags flags) { return (flags & RTC_INTERSECT_CONTEXT_FLAG_COHERENT) == RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT; }
+  /*! decoding of intersection flags, sorted ray streams are traced in coherent mode */
+  __forceinline bool isCoherent  (RTCIntersectContextFlags flags) { return (flags & (RTC_INTERSECT_CONTEXT_FLAG_COHERENT | RTC_INTERSECT_CONTEXT_FLAG_SORT)) != 0; }
+  __forceinline bool isIncoherent(RTCIntersectContextFlags flags) { return (flags & (RTC_INTERSECT_CONTEXT_FLAG_COHERENT | RTC_INTERSECT_CONTEXT_FLAG_SORT)) == 0; }
+  __forceinline bool isSorted    (RTCIntersectContextFlags flags) { return (flags & RTC_INTERSECT_CONTEXT_FLAG_SORT) == RTC_INTERSECT_CONTEXT_FLAG_SORT; }
 
 #if defined(TASKING_TBB) && (TBB_INTERFACE_VERSION_MAJOR >= 8)
 #  define USE_TASK_ARENA 1
@@ -34,9 +34,12 @@ namespace embree
       flags_modified(true), enabled_geometry_types(0),
       scene_flags(RTC_SCENE_FLAG_NONE),
       quality_flags(RTC_BUILD_QUALITY_MEDIUM),
+      build_priority(0), build_max_threads(0),
       is_build(false), modified(true),
+      async_commit(false), async_commit_thread(nullptr), async_commit_function(nullptr), async_commit_ptr(nullptr),
+      published_accel(nullptr), retired_accel(nullptr),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), 
-      numIntersectionFiltersN(0)
+      numIntersectionFiltersN(0), halfVertices(false)
   {
     device->refInc();
 
@@ -59,6 +62,10 @@ namespace embree
 
   Scene::~Scene () 
   {
+    joinAsyncCommit();
+    delete published_accel.load();
+    delete retired_accel;
+
 #if defined(TASKING_TBB) || defined(TASKING_PPL)
     delete group; group = nullptr;
 #endif
@@ -154,7 +161,7 @@ namespace embree
             accels_add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
 
           break;
-        case /*0b10*/ 2: accels_add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
+        case /*0b10*/ 2: accels_add(device->bvh4_factory->BVH4Triangle4q(this)); break;
         case /*0b11*/ 3: accels_add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
@@ -188,6 +195,7 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4v")      accels_add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels_add(device->bvh4_factory->BVH4Triangle4i(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels_add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle4q")      accels_add(device->bvh4_factory->BVH4Triangle4q(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->tri_accel == "bvh8.triangle4")       accels_add(device->bvh8_factory->BVH8Triangle4 (this));
@@ -508,6 +516,13 @@ namespace embree
 #endif
   }
 
+  void Scene::createUnifiedAccel()
+  {
+#if defined(EMBREE_GEOMETRY_CURVE) || defined(EMBREE_GEOMETRY_POINT)
+    accels_add(device->bvh4_factory->BVH4Unified(this));
+#endif
+  }
+
   void Scene::createInstanceMBAccel()
   {
 #if defined(EMBREE_GEOMETRY_INSTANCE)
@@ -610,6 +625,128 @@ namespace embree
     is_build = true;
   }
 
+  /* ray queries of asynchronously committed scenes operate on the currently published acceleration structures */
+  static AccelN* published (Accel::Intersectors* This) {
+    return ((Scene*)This->ptr)->published_accel.load();
+  }
+
+  static void published_intersect (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context) {
+    published(This)->intersectors.intersect(ray,context);
+  }
+
+  static void published_intersect4 (const void* valid, Accel::Intersectors* This, RTCRayHit4& ray, IntersectContext* context) {
+    published(This)->intersectors.intersect4(valid,ray,context);
+  }
+
+  static void published_intersect8 (const void* valid, Accel::Intersectors* This, RTCRayHit8& ray, IntersectContext* context) {
+    published(This)->intersectors.intersect8(valid,ray,context);
+  }
+
+  static void published_intersect16 (const void* valid, Accel::Intersectors* This, RTCRayHit16& ray, IntersectContext* context) {
+    published(This)->intersectors.intersect16(valid,ray,context);
+  }
+
+  static void published_intersectN (Accel::Intersectors* This, RTCRayHitN** ray, const size_t N, IntersectContext* context) {
+    published(This)->intersectors.intersectN(ray,N,context);
+  }
+
+  static void published_occluded (Accel::Intersectors* This, RTCRay& ray, IntersectContext* context) {
+    published(This)->intersectors.occluded(ray,context);
+  }
+
+  static void published_occluded4 (const void* valid, Accel::Intersectors* This, RTCRay4& ray, IntersectContext* context) {
+    published(This)->intersectors.occluded4(valid,ray,context);
+  }
+
+  static void published_occluded8 (const void* valid, Accel::Intersectors* This, RTCRay8& ray, IntersectContext* context) {
+    published(This)->intersectors.occluded8(valid,ray,context);
+  }
+
+  static void published_occluded16 (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context) {
+    published(This)->intersectors.occluded16(valid,ray,context);
+  }
+
+  static void published_occludedN (Accel::Intersectors* This, RTCRayN** ray, const size_t N, IntersectContext* context) {
+    published(This)->intersectors.occludedN(ray,N,context);
+  }
+
+  static bool published_pointQuery (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) {
+    return published(This)->intersectors.pointQuery(query,context);
+  }
+
+  static void async_commit_thread_func (Scene* scene)
+  {
+    RTCError error = RTC_ERROR_NONE;
+    try {
+      scene->commit(false);
+    } catch (std::bad_alloc&) {
+      error = RTC_ERROR_OUT_OF_MEMORY;
+      Device::process_error(scene->device,error,"out of memory");
+    } catch (rtcore_error& e) {
+      error = e.error;
+      Device::process_error(scene->device,error,e.what());
+    } catch (std::exception& e) {
+      error = RTC_ERROR_UNKNOWN;
+      Device::process_error(scene->device,error,e.what());
+    } catch (...) {
+      error = RTC_ERROR_UNKNOWN;
+      Device::process_error(scene->device,error,"unknown exception caught");
+    }
+    if (scene->async_commit_function)
+      scene->async_commit_function(scene->async_commit_ptr,(RTCScene)scene,error);
+  }
+
+  void Scene::commitAsync (RTCCommitCompletionFunction completion, void* ptr)
+  {
+    joinAsyncCommit();
+
+    /* switch to publishing acceleration structures, the current ones stay visible until the commit completes */
+    if (!async_commit)
+    {
+      AccelN* accel = new AccelN;
+      accel->accels.swap(accels);
+      accel->type = type;
+      accel->bounds = bounds;
+      accel->intersectors = intersectors;
+      if (accel->intersectors.ptr == this)
+        accel->intersectors.ptr = accel;
+      published_accel = accel;
+      flags_modified = true;
+      
+      Accel::Intersectors proxy;
+      proxy.ptr = this;
+      proxy.intersector1  = Accel::Intersector1(&published_intersect,&published_occluded,&published_pointQuery,"Scene::intersector1");
+      proxy.intersector4  = Accel::Intersector4(&published_intersect4,&published_occluded4,accel->intersectors.intersector4 ? "Scene::intersector4" : nullptr);
+      proxy.intersector8  = Accel::Intersector8(&published_intersect8,&published_occluded8,accel->intersectors.intersector8 ? "Scene::intersector8" : nullptr);
+      proxy.intersector16 = Accel::Intersector16(&published_intersect16,&published_occluded16,accel->intersectors.intersector16 ? "Scene::intersector16" : nullptr);
+      proxy.intersectorN  = Accel::IntersectorN(&published_intersectN,&published_occludedN,"Scene::intersectorN");
+      intersectors = proxy;
+      async_commit = true;
+    }
+
+    async_commit_function = completion;
+    async_commit_ptr = ptr;
+    async_commit_thread = createThread((thread_func)async_commit_thread_func,this);
+  }
+
+  void Scene::joinAsyncCommit ()
+  {
+    if (!async_commit_thread) return;
+    join(async_commit_thread);
+    async_commit_thread = nullptr;
+  }
+
+  void Scene::publishAccel (AccelN* accel)
+  {
+    /* rays traced against the previously published acceleration structures may still be in flight, thus these get released on the next publication */
+    delete retired_accel;
+    retired_accel = published_accel.exchange(accel);
+    bounds = accel->bounds;
+    intersectors.intersector4.name  = accel->intersectors.intersector4  ? "Scene::intersector4"  : nullptr;
+    intersectors.intersector8.name  = accel->intersectors.intersector8  ? "Scene::intersector8"  : nullptr;
+    intersectors.intersector16.name = accel->intersectors.intersector16 ? "Scene::intersector16" : nullptr;
+  }
+
   void Scene::commit_task ()
   {
     /* print scene statistics */
@@ -636,37 +773,66 @@ namespace embree
           if (geometries[i]) geometries[i]->setModified();
         });
       
-      if (getNumPrimitives<TriangleMesh,false>()) createTriangleAccel();
+      /* in unified mode static triangles, quads, curves, user geometries, and 
+         instances share one acceleration structure if more than one of these types is present */
+      bool unified = false;
+#if defined(EMBREE_GEOMETRY_CURVE) || defined(EMBREE_GEOMETRY_POINT)
+      if (isUnifiedAccel())
+      {
+        const size_t numUnifiedTypes =
+          size_t(getNumPrimitives<TriangleMesh,false>() != 0) + size_t(getNumPrimitives<QuadMesh,false>() != 0) +
+          size_t(getNumPrimitives<CurveGeometry,false>() != 0) + size_t(getNumPrimitives<UserGeometry,false>() != 0) +
+          size_t(getNumPrimitives<Instance,false>() != 0);
+        unified = numUnifiedTypes > 1;
+      }
+#endif
+      if (unified) createUnifiedAccel();
+
+      if (!unified && getNumPrimitives<TriangleMesh,false>()) createTriangleAccel();
       if (getNumPrimitives<TriangleMesh,true>()) createTriangleMBAccel();
-      if (getNumPrimitives<QuadMesh,false>()) createQuadAccel();
+      if (!unified && getNumPrimitives<QuadMesh,false>()) createQuadAccel();
       if (getNumPrimitives<QuadMesh,true>()) createQuadMBAccel();
       if (getNumPrimitives<GridMesh,false>()) createGridAccel();
       if (getNumPrimitives<GridMesh,true>()) createGridMBAccel();
       if (getNumPrimitives<SubdivMesh,false>()) createSubdivAccel();
       if (getNumPrimitives<SubdivMesh,true>()) createSubdivMBAccel();
-      if (getNumPrimitives<CurveGeometry,false>()) createHairAccel();
+      if (!unified && getNumPrimitives<CurveGeometry,false>()) createHairAccel();
       if (getNumPrimitives<CurveGeometry,true>()) createHairMBAccel();
-      if (getNumPrimitives<UserGeometry,false>()) createUserGeometryAccel();
+      if (!unified && getNumPrimitives<UserGeometry,false>()) createUserGeometryAccel();
       if (getNumPrimitives<UserGeometry,true>()) createUserGeometryMBAccel();
-      if (getNumPrimitives<Instance,false>()) createInstanceAccel();
+      if (!unified && getNumPrimitives<Instance,false>()) createInstanceAccel();
       if (getNumPrimitives<Instance,true>()) createInstanceMBAccel();
       
       flags_modified = false;
       enabled_geometry_types = new_enabled_geometry_types;
     }
     
+    /* asynchronously committed scenes build into a shadow set of acceleration structures */
+    std::unique_ptr<AccelN> shadow;
+    AccelN* accel = this;
+    if (async_commit) {
+      shadow.reset(new AccelN);
+      shadow->accels.swap(accels);
+      accel = shadow.get();
+      flags_modified = true; // next commit has to create new accels
+    }
+
     /* select fast code path if no filter function is present */
-    accels_select(hasFilterFunction());
+    accel->accels_select(hasFilterFunction());
   
     /* build all hierarchies of this scene */
-    accels_build();
+    accel->accels_build();
 
     /* make static geometry immutable */
     if (!isDynamicAccel()) {
-      accels_immutable();
+      accel->accels_immutable();
       flags_modified = true; // in non-dynamic mode we have to re-create accels
     }
 
+    /* replicate static hierarchies into the memory of each NUMA node */
+    if (isNumaReplicatedAccel())
+      accel->accels_replicate();
+
     /* call postCommit function of each geometry */
     parallel_for(geometries.size(), [&] ( const size_t i ) {
         if (geometries[i] && geometries[i]->isEnabled())
@@ -677,10 +843,13 @@ namespace embree
 
     if (device->verbosity(2)) {
       std::cout << "created scene intersector" << std::endl;
-      accels_print(2);
+      accel->accels_print(2);
       std::cout << "selected scene intersector" << std::endl;
-      intersectors.print(2);
+      accel->intersectors.print(2);
     }
+
+    if (shadow)
+      publishAccel(shadow.release());
     
     setModified(false);
   }
@@ -706,6 +875,14 @@ namespace embree
   RTCSceneFlags Scene::getSceneFlags() const {
     return scene_flags;
   }
+
+  void Scene::setBuildPriority(int priority) {
+    build_priority = priority;
+  }
+
+  void Scene::setBuildThreadLimit(size_t maxThreads) {
+    build_max_threads = maxThreads;
+  }
                    
 #if defined(TASKING_INTERNAL)
 
@@ -721,6 +898,8 @@ namespace embree
       if (scheduler == null) {
         buildLock.lock();
         this->scheduler = scheduler = new TaskScheduler;
+        scheduler->setPriority(build_priority);
+        scheduler->setMaxThreads(build_max_threads);
       }
     }
 
@@ -811,7 +990,10 @@ namespace embree
 #else
       tbb::task_group_context ctx( tbb::task_group_context::isolated, tbb::task_group_context::default_traits | tbb::task_group_context::fp_settings );
 #endif
-      //ctx.set_priority(tbb::priority_high);
+#if __TBB_TASK_PRIORITY
+      if (build_priority != 0)
+        ctx.set_priority(build_priority > 0 ? tbb::priority_high : tbb::priority_low);
+#endif
 
 #if USE_TASK_ARENA
       device->arena->execute([&]{
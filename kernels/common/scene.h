@@ -169,6 +169,7 @@ namespace embree
     void createUserGeometryMBAccel();
     void createInstanceAccel();
     void createInstanceMBAccel();
+    void createUnifiedAccel();
     void createGridAccel();
     void createGridMBAccel();
 
@@ -186,9 +187,22 @@ namespace embree
     
     void setSceneFlags(RTCSceneFlags scene_flags);
     RTCSceneFlags getSceneFlags() const;
+
+    /*! sets the priority and thread limit of the following builds of the scene */
+    void setBuildPriority(int priority);
+    void setBuildThreadLimit(size_t maxThreads);
     
     void commit (bool join);
     void commit_task ();
+
+    /*! commits the scene in a background thread, ray queries operate on the previous scene version until the commit completes */
+    void commitAsync (RTCCommitCompletionFunction completion, void* ptr);
+
+    /*! waits for a pending asynchronous commit */
+    void joinAsyncCommit ();
+
+    /*! makes new acceleration structures visible to ray queries of an asynchronously committed scene */
+    void publishAccel (AccelN* accel);
     void build () {}
 
     void updateInterface();
@@ -202,6 +216,9 @@ namespace embree
     /* determines if scene is modified */
     __forceinline bool isModified() const { return modified; }
 
+    /* determines if ray queries can operate on the scene, asynchronously committed scenes stay valid while modified */
+    __forceinline bool isCommitted() const { return !modified || async_commit; }
+
     /* sets modified flag */
     __forceinline void setModified(bool f = true) { 
       modified = f; 
@@ -244,6 +261,8 @@ namespace embree
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
+    __forceinline bool isUnifiedAccel() const { return (scene_flags & RTC_SCENE_FLAG_UNIFIED_ACCEL) && isStaticAccel() && !isRobustAccel(); }
+    __forceinline bool isNumaReplicatedAccel() const { return ((scene_flags & RTC_SCENE_FLAG_NUMA_REPLICATE) || device->alloc_numa_policy == State::NUMA_POLICY_REPLICATE) && isStaticAccel(); }
     
     __forceinline bool hasContextFilterFunction() const {
       return scene_flags & RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION;
@@ -254,6 +273,9 @@ namespace embree
     __forceinline bool hasFilterFunction() {
       return hasContextFilterFunction() || hasGeometryFilterFunction();
     }
+    __forceinline bool hasHalfVertices() const {
+      return halfVertices;
+    }
     
     /* test if scene got already build */
     __forceinline bool isBuild() const { return is_build; }
@@ -272,10 +294,20 @@ namespace embree
     
     RTCSceneFlags scene_flags;
     RTCBuildQuality quality_flags;
+    int build_priority;              //!< worker threads prefer builds of higher priority
+    size_t build_max_threads;        //!< maximal number of threads working on a build, 0 means no limit
     MutexSys buildMutex;
     SpinLock geometriesMutex;
     bool is_build;
     bool modified;                   //!< true if scene got modified
+
+    /*! asynchronous commits build into a shadow set of acceleration structures that gets published on completion */
+    bool async_commit;                                //!< true once the scene got committed asynchronously
+    thread_t async_commit_thread;                     //!< thread performing the pending asynchronous commit
+    RTCCommitCompletionFunction async_commit_function;
+    void* async_commit_ptr;
+    std::atomic<AccelN*> published_accel;             //!< acceleration structures ray queries operate on
+    AccelN* retired_accel;                            //!< previously published acceleration structures
     
     /*! global lock step task scheduler */
 #if defined(TASKING_INTERNAL) 
@@ -372,6 +404,7 @@ namespace embree
     }
    
     std::atomic<size_t> numIntersectionFiltersN;   //!< number of enabled intersection/occlusion filters for N-wide ray packets
+    std::atomic<bool> halfVertices;                //!< true if some triangle or quad mesh stores its vertices as half precision floats
   };
 
   template<> __forceinline size_t Scene::getNumPrimitives<TriangleMesh,false>() const { return world.numTriangles; }
@@ -65,9 +65,13 @@ namespace embree
 
     if (type == RTC_BUFFER_TYPE_VERTEX)
     {
-      if (format != RTC_FORMAT_FLOAT3)
+      if (format != RTC_FORMAT_FLOAT3 && format != RTC_FORMAT_HALF3 && format != RTC_FORMAT_HALF4)
         throw_RTCError(RTC_ERROR_INVALID_OPERATION, "invalid vertex buffer format");
 
+      /* half precision vertices are loaded with 8 byte loads */
+      if ((format == RTC_FORMAT_HALF3 || format == RTC_FORMAT_HALF4) && stride < 8)
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION, "stride of half precision vertex buffers has to be at least 8 bytes");
+
       /* if buffer is larger than 16GB the premultiplied index optimization does not work */
       if (stride*num > 16ll*1024ll*1024ll*1024ll)
         throw_RTCError(RTC_ERROR_INVALID_OPERATION, "vertex buffer can be at most 16GB large");
@@ -76,7 +80,8 @@ namespace embree
         throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid vertex buffer slot");
 
       vertices[slot].set(buffer, offset, stride, num, format);
-      vertices[slot].checkPadding16();
+      if (format == RTC_FORMAT_FLOAT3)
+        vertices[slot].checkPadding16();
       vertices0 = vertices[0];
     }
     else if (type == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE)
@@ -159,6 +164,25 @@ namespace embree
     Geometry::update();
   }
 
+  void TriangleMesh::updateBuffer(RTCBufferType type, unsigned int slot, unsigned int begin, unsigned int count)
+  {
+    /* only vertex buffers track modified ranges, all other buffers are updated entirely */
+    if (type != RTC_BUFFER_TYPE_VERTEX) {
+      updateBuffer(type,slot);
+      return;
+    }
+
+    if (slot >= vertices.size())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer slot");
+    if (size_t(begin)+size_t(count) > vertices[slot].size())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer range");
+    if (count == 0)
+      return;
+
+    vertices[slot].setModified(begin,size_t(begin)+size_t(count));
+    Geometry::update();
+  }
+
   void TriangleMesh::preCommit() 
   {
     /* verify that stride of all time steps are identical */
@@ -166,6 +190,15 @@ namespace embree
       if (vertices[t].getStride() != vertices[0].getStride())
         throw_RTCError(RTC_ERROR_INVALID_OPERATION,"stride of vertex buffers have to be identical for each time step");
 
+    /* verify that format of all time steps are identical */
+    for (unsigned int t=0; t<numTimeSteps; t++)
+      if (vertices[t].getFormat() != vertices[0].getFormat())
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"format of vertex buffers have to be identical for each time step");
+
+    /* Triangle4i and Quad4i leaves have to convert half precision vertices */
+    if (hasHalfVertices())
+      scene->halfVertices = true;
+
     Geometry::preCommit();
   }
 
@@ -231,23 +264,25 @@ namespace embree
            (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE && bufferSlot <= vertexAttribs.size()));
     const char* src = nullptr; 
     size_t stride = 0;
+    bool half = false;
     if (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE) {
       src    = vertexAttribs[bufferSlot].getPtr();
       stride = vertexAttribs[bufferSlot].getStride();
     } else {
       src    = vertices[bufferSlot].getPtr();
       stride = vertices[bufferSlot].getStride();
+      half   = vertices[bufferSlot].getFormat() == RTC_FORMAT_HALF3 || vertices[bufferSlot].getFormat() == RTC_FORMAT_HALF4;
     }
     
     for (unsigned int i=0; i<valueCount; i+=4)
     {
-      size_t ofs = i*sizeof(float);
+      size_t ofs = i*(half ? sizeof(short) : sizeof(float));
       const float w = 1.0f-u-v;
       const Triangle& tri = triangle(primID);
       const vbool4 valid = vint4((int)i)+vint4(step) < vint4(int(valueCount));
-      const vfloat4 p0 = vfloat4::loadu(valid,(float*)&src[tri.v[0]*stride+ofs]);
-      const vfloat4 p1 = vfloat4::loadu(valid,(float*)&src[tri.v[1]*stride+ofs]);
-      const vfloat4 p2 = vfloat4::loadu(valid,(float*)&src[tri.v[2]*stride+ofs]);
+      const vfloat4 p0 = half ? vfloat4::load_half(valid,&src[tri.v[0]*stride+ofs]) : vfloat4::loadu(valid,(float*)&src[tri.v[0]*stride+ofs]);
+      const vfloat4 p1 = half ? vfloat4::load_half(valid,&src[tri.v[1]*stride+ofs]) : vfloat4::loadu(valid,(float*)&src[tri.v[1]*stride+ofs]);
+      const vfloat4 p2 = half ? vfloat4::load_half(valid,&src[tri.v[2]*stride+ofs]) : vfloat4::loadu(valid,(float*)&src[tri.v[2]*stride+ofs]);
       
       if (P) {
         vfloat4::storeu(valid,P+i,madd(w,p0,madd(u,p1,v*p2)));
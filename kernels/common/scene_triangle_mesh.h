@@ -53,6 +53,7 @@ namespace embree
     void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num);
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
+    void updateBuffer(RTCBufferType type, unsigned int slot, unsigned int begin, unsigned int count);
     void preCommit();
     void postCommit();
     bool verify();
@@ -70,8 +71,20 @@ namespace embree
       return triangles[i];
     }
 
+    /*! returns true if the vertices are stored as half precision floats */
+    __forceinline bool hasHalfVertices() const {
+      return vertices0.getFormat() == RTC_FORMAT_HALF3 || vertices0.getFormat() == RTC_FORMAT_HALF4;
+    }
+
+    /*! loads a vertex from some pointer into a vertex buffer */
+    __forceinline const Vec3fa loadVertex(const void* ptr) const {
+      if (unlikely(hasHalfVertices())) return Vec3fa::loadu_half(ptr);
+      return Vec3fa::loadu(ptr);
+    }
+
     /*! returns i'th vertex of the first time step  */
     __forceinline const Vec3fa vertex(size_t i) const {
+      if (unlikely(hasHalfVertices())) return Vec3fa::loadu_half(vertices0.getPtr(i));
       return vertices0[i];
     }
 
@@ -82,6 +95,7 @@ namespace embree
 
     /*! returns i'th vertex of itime'th timestep */
     __forceinline const Vec3fa vertex(size_t i, size_t itime) const {
+      if (unlikely(hasHalfVertices())) return Vec3fa::loadu_half(vertices[itime].getPtr(i));
       return vertices[itime][i];
     }
 
@@ -19,6 +19,10 @@
 namespace embree
 {
   Stat Stat::instance; 
+  std::atomic<bool> Stat::enabled(false);
+  __thread Stat::ThreadCounters* Stat::thread_counters = nullptr;
+  Stat::ThreadCounters* Stat::thread_counters_list = nullptr;
+  SpinLock Stat::thread_counters_mutex;
   
   Stat::Stat () {
   }
@@ -41,6 +45,7 @@ namespace embree
     cout << "  #normal_travs   = " << float(data.normal.travs            )*1E-6 << "M" << std::endl;
     cout << "    #nodes        = " << float(data.normal.trav_nodes       )*1E-6 << "M" << std::endl;
     cout << "    #nodes_xfm    = " << float(data.normal.trav_xfm_nodes   )*1E-6 << "M" << std::endl;
+    cout << "    #filters      = " << float(data.normal.trav_filters     )*1E-6 << "M" << std::endl;
     cout << "    #leaves       = " << float(data.normal.trav_leaves      )*1E-6 << "M" << std::endl;
     cout << "    #prims        = " << float(data.normal.trav_prims       )*1E-6 << "M" << std::endl;
     cout << "    #prim_hits    = " << float(data.normal.trav_prim_hits   )*1E-6 << "M" << std::endl;
@@ -73,6 +78,7 @@ namespace embree
       cout << "    #leaves     = " << float(data.shadow.trav_leaves   )*1E-6 << "M" << std::endl;
       cout << "    #prims      = " << float(data.shadow.trav_prims    )*1E-6 << "M" << std::endl;
       cout << "    #prim_hits  = " << float(data.shadow.trav_prim_hits)*1E-6 << "M" << std::endl;
+      cout << "    #filters    = " << float(data.shadow.trav_filters  )*1E-6 << "M" << std::endl;
 
       cout << "    #stack nodes = " << float(data.shadow.trav_stack_nodes )*1E-6 << "M" << std::endl;
       cout << "    #stack pop   = " << float(data.shadow.trav_stack_pop )*1E-6 << "M" << std::endl;
@@ -138,4 +144,41 @@ namespace embree
     cout << "#user7/user3 " << 100.0f*float(cntrs.user[7])/float(cntrs.user[3]) << "%" << std::endl;
     cout << std::endl;
   }
+
+  void Stat::registerThread()
+  {
+    ThreadCounters* counters = new ThreadCounters;
+    Lock<SpinLock> lock(thread_counters_mutex);
+    counters->next = thread_counters_list;
+    thread_counters_list = counters;
+    thread_counters = counters;
+  }
+
+  void Stat::enable(bool enabled) {
+    Stat::enabled = enabled;
+  }
+
+  void Stat::clearThreadCounters()
+  {
+    Lock<SpinLock> lock(thread_counters_mutex);
+    for (ThreadCounters* counters = thread_counters_list; counters; counters = counters->next)
+      counters->clear();
+  }
+
+  Stat::ThreadCounters Stat::sumThreadCounters()
+  {
+    ThreadCounters sum;
+    Lock<SpinLock> lock(thread_counters_mutex);
+    for (ThreadCounters* counters = thread_counters_list; counters; counters = counters->next)
+    {
+      const size_t* src = (const size_t*) &counters->normal;
+      size_t* dst = (size_t*) &sum.normal;
+      for (size_t i=0; i<sizeof(sum.normal)/sizeof(size_t); i++) dst[i] += src[i];
+      src = (const size_t*) &counters->shadow;
+      dst = (size_t*) &sum.shadow;
+      for (size_t i=0; i<sizeof(sum.shadow)/sizeof(size_t); i++) dst[i] += src[i];
+    }
+    sum.next = nullptr;
+    return sum;
+  }
 }
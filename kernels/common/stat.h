@@ -18,17 +18,22 @@
 
 #include "default.h"
 
+/* Macro to gather the per thread statistics that are enabled at runtime */
+#define STAT_RUNTIME(s,y) \
+  do { if (unlikely(Stat::enabled)) Stat::local().s += (y); } while (0)
+
 /* Macros to gather statistics */
 #ifdef EMBREE_STAT_COUNTERS
 #  define STAT(x) x
 #  define STAT3(s,x,y,z) \
   STAT(Stat::get().code  .s+=x);               \
   STAT(Stat::get().active.s+=y);               \
-  STAT(Stat::get().all   .s+=z);
+  STAT(Stat::get().all   .s+=z);               \
+  STAT_RUNTIME(s,y)
 #  define STAT_USER(i,x) Stat::get().user[i]+=x;
 #else
-#  define STAT(x)
-#  define STAT3(s,x,y,z)
+#  define STAT(x) do { if (unlikely(Stat::enabled)) { x } } while (0)
+#  define STAT3(s,x,y,z) STAT_RUNTIME(s,y)
 #  define STAT_USER(i,x) 
 #endif
 
@@ -88,6 +93,7 @@ namespace embree
               trav_stack_pop.store(0);
               trav_stack_nodes.store(0); 
               trav_xfm_nodes.store(0); 
+              trav_filters.store(0);
             }
 
           public:
@@ -100,6 +106,7 @@ namespace embree
 	    std::atomic<size_t> trav_stack_pop;
 	    std::atomic<size_t> trav_stack_nodes; 
             std::atomic<size_t> trav_xfm_nodes; 
+            std::atomic<size_t> trav_filters;
             
 	  } normal, shadow;
 	} all, active, code; 
@@ -107,6 +114,39 @@ namespace embree
         std::atomic<size_t> user[10];
     };
 
+    /*! Per thread counters of the statistics that can be enabled at
+     *  runtime. Only the owning thread writes to the counters, thus no
+     *  atomic operations are required when tracing rays. */
+    struct __aligned(64) ThreadCounters
+    {
+      ALIGNED_STRUCT_(64);
+
+      ThreadCounters () : next(nullptr) {
+        clear();
+      }
+
+      void clear() {
+        memset(&normal,0,sizeof(normal));
+        memset(&shadow,0,sizeof(shadow));
+      }
+
+      struct 
+      {
+        size_t travs;
+        size_t trav_nodes;
+        size_t trav_leaves;
+        size_t trav_prims;
+        size_t trav_prim_hits;
+        size_t trav_hit_boxes[SIZE_HISTOGRAM+1];
+        size_t trav_stack_pop;
+        size_t trav_stack_nodes; 
+        size_t trav_xfm_nodes; 
+        size_t trav_filters;
+      } normal, shadow;
+
+      ThreadCounters* next;
+    };
+
   public:
 
     static __forceinline Counters& get() {
@@ -119,10 +159,36 @@ namespace embree
     
     static void print(std::ostream& cout);
 
+    /*! returns the runtime counters of the calling thread */
+    static __forceinline ThreadCounters& local() 
+    {
+      if (unlikely(!thread_counters))
+        registerThread();
+      return *thread_counters;
+    }
+
+    /*! enables or disables gathering of runtime statistics */
+    static void enable(bool enabled);
+
+    /*! clears the runtime counters of all threads */
+    static void clearThreadCounters();
+
+    /*! sums up the runtime counters of all threads */
+    static ThreadCounters sumThreadCounters();
+
+  private:
+    static void registerThread();
+
+  public:
+    static std::atomic<bool> enabled;     //!< true if runtime statistics are gathered
+
   private: 
     Counters cntrs;
 
   private:
     static Stat instance;
+    static __thread ThreadCounters* thread_counters;
+    static ThreadCounters* thread_counters_list;
+    static SpinLock thread_counters_mutex;
   };
 }
@@ -98,6 +98,9 @@ namespace embree
     useSpatialPreSplits = false;
 
     tessellation_cache_size = 128*1024*1024;
+    tessellation_cache_partitions = 0;
+    bvh_cache_dir = "";
+    stream_sort_size = 1024;
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
@@ -142,6 +145,7 @@ namespace embree
     alloc_num_main_slots = 0;
     alloc_thread_block_size = 0;
     alloc_single_thread_alloc = -1;
+    alloc_numa_policy = NUMA_POLICY_DEFAULT;
 
     error_function = nullptr;
     error_function_userptr = nullptr;
@@ -414,6 +418,8 @@ namespace embree
             if (flag == Token::Id("dynamic") ) scene_flags |= RTC_SCENE_FLAG_DYNAMIC;
             else if (flag == Token::Id("compact")) scene_flags |= RTC_SCENE_FLAG_COMPACT;
             else if (flag == Token::Id("robust")) scene_flags |= RTC_SCENE_FLAG_ROBUST;
+            else if (flag == Token::Id("unified")) scene_flags |= RTC_SCENE_FLAG_UNIFIED_ACCEL;
+            else if (flag == Token::Id("numa_replicate")) scene_flags |= RTC_SCENE_FLAG_NUMA_REPLICATE;
           } while (cin->trySymbol("|"));
         }
       }
@@ -428,6 +434,14 @@ namespace embree
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_partitions") && cin->trySymbol("="))
+        tessellation_cache_partitions = cin->get().Int();
+
+      else if (tok == Token::Id("bvh_cache_dir") && cin->trySymbol("="))
+        bvh_cache_dir = cin->get().String();
+
+      else if (tok == Token::Id("stream_sort_size") && cin->trySymbol("="))
+        stream_sort_size = cin->get().Int();
 
       else if (tok == Token::Id("alloc_main_block_size") && cin->trySymbol("="))
         alloc_main_block_size = cin->get().Int();
@@ -437,6 +451,13 @@ namespace embree
          alloc_thread_block_size = cin->get().Int();
        else if (tok == Token::Id("alloc_single_thread_alloc") && cin->trySymbol("="))
          alloc_single_thread_alloc = cin->get().Int();
+       else if (tok == Token::Id("alloc_numa_policy") && cin->trySymbol("=")) {
+         std::string policy = cin->get().Identifier();
+         if      (policy == "default"   ) alloc_numa_policy = NUMA_POLICY_DEFAULT;
+         else if (policy == "local"     ) alloc_numa_policy = NUMA_POLICY_LOCAL;
+         else if (policy == "interleave") alloc_numa_policy = NUMA_POLICY_INTERLEAVE;
+         else if (policy == "replicate" ) alloc_numa_policy = NUMA_POLICY_REPLICATE;
+       }
 
       cin->trySymbol(","); // optional , separator
     }
@@ -465,9 +486,22 @@ namespace embree
     else if (hugepages_success) std::cout << "enabled" << std::endl;
     else std::cout << "failed" << std::endl;
 
+    std::cout << "  numa_policy   = ";
+    switch (alloc_numa_policy) {
+    case NUMA_POLICY_DEFAULT   : std::cout << "default" << std::endl; break;
+    case NUMA_POLICY_LOCAL     : std::cout << "local" << std::endl; break;
+    case NUMA_POLICY_INTERLEAVE: std::cout << "interleave" << std::endl; break;
+    case NUMA_POLICY_REPLICATE : std::cout << "replicate" << std::endl; break;
+    default: std::cout << "error" << std::endl; break;
+    }
+    std::cout << "  numa_nodes    = " << getNumberOfNumaNodes() << std::endl;
+
     std::cout << "  verbosity     = " << verbose << std::endl;
     std::cout << "  cache_size    = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  cache_partitions = " << tessellation_cache_partitions << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  bvh_cache_dir = " << bvh_cache_dir << std::endl;
+    std::cout << "  stream_sort_size = " << stream_sort_size << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel         = " << tri_accel << std::endl;
@@ -119,6 +119,9 @@ namespace embree
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    size_t tessellation_cache_partitions;  //!< number of partitions of the tessellation cache, 0 for one per NUMA node
+    std::string bvh_cache_dir;             //!< directory of the persistent BVH cache, disabled if empty
+    size_t stream_sort_size;               //!< number of rays sorted together by sorted ray stream mode
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -155,6 +158,12 @@ namespace embree
     int alloc_num_main_slots;              //!< number of such shared blocks to be used to allocate
     size_t alloc_thread_block_size;        //!< size of thread local allocator block size
     int alloc_single_thread_alloc;         //!< in single mode nodes and leaves use same thread local allocator
+    enum NUMA_POLICY {
+      NUMA_POLICY_DEFAULT,                 //!< memory pages are placed by the OS on first touch
+      NUMA_POLICY_LOCAL,                   //!< blocks are placed on the NUMA node of the building thread
+      NUMA_POLICY_INTERLEAVE,              //!< blocks are interleaved over all NUMA nodes
+      NUMA_POLICY_REPLICATE                //!< static scenes are replicated into the memory of each NUMA node
+    } alloc_numa_policy;                   //!< placement policy of allocator blocks on NUMA systems
 
   public:
 
@@ -35,6 +35,12 @@
 #include "curve_intersector_oriented.h"
 #include "curve_intersector_sweep.h"
 
+#include "unified.h"
+#include "trianglev_intersector.h"
+#include "quadv_intersector.h"
+#include "object_intersector.h"
+#include "instance_intersector.h"
+
 namespace embree
 {
   namespace isa
@@ -457,6 +463,90 @@ namespace embree
       return intersectors;
     }
 
+    /*! Intersects a leaf of the unified BVH that stores blocks of a
+     *  primitive type without curve precalculations. */
+    template<typename Intersector>
+    struct UnifiedLeafIntersector1
+    {
+      typedef typename Intersector::Primitive Primitive;
+
+      static void intersect(void* pre, void* ray, IntersectContext* context, const void* prim)
+      {
+        const UnifiedLeaf* leaf = (const UnifiedLeaf*) prim;
+        typename Intersector::Precalculations lpre(*(Ray*)ray,nullptr);
+        for (size_t i=0; i<leaf->size(); i++)
+          Intersector::intersect(lpre,*(RayHit*)ray,context,leaf->template block<Primitive>(i));
+      }
+
+      static bool occluded(void* pre, void* ray, IntersectContext* context, const void* prim)
+      {
+        const UnifiedLeaf* leaf = (const UnifiedLeaf*) prim;
+        typename Intersector::Precalculations lpre(*(Ray*)ray,nullptr);
+        for (size_t i=0; i<leaf->size(); i++)
+          if (Intersector::occluded(lpre,*(Ray*)ray,context,leaf->template block<Primitive>(i)))
+            return true;
+        return false;
+      }
+
+      static bool pointQuery(PointQuery* query, PointQueryContext* context, const void* prim)
+      {
+        const UnifiedLeaf* leaf = (const UnifiedLeaf*) prim;
+        bool changed = false;
+        for (size_t i=0; i<leaf->size(); i++)
+          changed |= Intersector::pointQuery(query,context,leaf->template block<Primitive>(i));
+        return changed;
+      }
+    };
+
+    template<int K, typename Intersector>
+    struct UnifiedLeafIntersectorK
+    {
+      typedef typename Intersector::Primitive Primitive;
+
+      static void intersect(void* pre, void* ray, size_t k, IntersectContext* context, const void* prim)
+      {
+        const UnifiedLeaf* leaf = (const UnifiedLeaf*) prim;
+        RayHitK<K>& rayK = *(RayHitK<K>*)ray;
+        typename Intersector::Precalculations lpre(vbool<K>(true),rayK);
+        for (size_t i=0; i<leaf->size(); i++)
+          Intersector::intersect(lpre,rayK,k,context,leaf->template block<Primitive>(i));
+      }
+
+      static bool occluded(void* pre, void* ray, size_t k, IntersectContext* context, const void* prim)
+      {
+        const UnifiedLeaf* leaf = (const UnifiedLeaf*) prim;
+        RayK<K>& rayK = *(RayK<K>*)ray;
+        typename Intersector::Precalculations lpre(vbool<K>(true),rayK);
+        for (size_t i=0; i<leaf->size(); i++)
+          if (Intersector::occluded(lpre,rayK,k,context,leaf->template block<Primitive>(i)))
+            return true;
+        return false;
+      }
+    };
+
+    template<int K> using Triangle4vIntersectorKMoeller = TriangleMvIntersectorKMoeller<SIMD_MODE(4),K,true>;
+    template<int K> using Quad4vIntersectorKMoeller = QuadMvIntersectorKMoeller<4,K,true>;
+    template<int K> using ObjectIntersectorKNoMB = ObjectIntersectorK<K,false>;
+
+    template<typename Intersector1, template<int K> class IntersectorK>
+    static void setUnifiedLeafIntersectors(VirtualCurveIntersector& prim, Geometry::GType gtype)
+    {
+      VirtualCurveIntersector::Intersectors& intersectors = prim.vtbl[gtype];
+      intersectors.intersect1 = &UnifiedLeafIntersector1<Intersector1>::intersect;
+      intersectors.occluded1  = &UnifiedLeafIntersector1<Intersector1>::occluded;
+      intersectors.intersect4 = &UnifiedLeafIntersectorK<4,IntersectorK<4>>::intersect;
+      intersectors.occluded4  = &UnifiedLeafIntersectorK<4,IntersectorK<4>>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = &UnifiedLeafIntersectorK<8,IntersectorK<8>>::intersect;
+      intersectors.occluded8  = &UnifiedLeafIntersectorK<8,IntersectorK<8>>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = &UnifiedLeafIntersectorK<16,IntersectorK<16>>::intersect;
+      intersectors.occluded16  = &UnifiedLeafIntersectorK<16,IntersectorK<16>>::occluded;
+#endif
+      prim.pointQueries[gtype] = &UnifiedLeafIntersector1<Intersector1>::pointQuery;
+    }
+
     VirtualCurveIntersector* VirtualCurveIntersector4i()
     {
       static VirtualCurveIntersector function_local_static_prim;
@@ -514,6 +604,25 @@ namespace embree
       return &function_local_static_prim;
     }
 
+    VirtualCurveIntersector* VirtualUnifiedIntersector4i()
+    {
+      static VirtualCurveIntersector function_local_static_prim;
+      function_local_static_prim = *VirtualCurveIntersector4i();
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+      setUnifiedLeafIntersectors<TriangleMvIntersector1Moeller<SIMD_MODE(4),true>,Triangle4vIntersectorKMoeller>(function_local_static_prim,Geometry::GTY_TRIANGLE_MESH);
+#endif
+#if defined(EMBREE_GEOMETRY_QUAD)
+      setUnifiedLeafIntersectors<QuadMvIntersector1Moeller<4,true>,Quad4vIntersectorKMoeller>(function_local_static_prim,Geometry::GTY_QUAD_MESH);
+#endif
+#if defined(EMBREE_GEOMETRY_USER)
+      setUnifiedLeafIntersectors<ObjectIntersector1<false>,ObjectIntersectorKNoMB>(function_local_static_prim,Geometry::GTY_USER_GEOMETRY);
+#endif
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+      setUnifiedLeafIntersectors<InstanceIntersector1,InstanceIntersectorK>(function_local_static_prim,Geometry::GTY_INSTANCE);
+#endif
+      return &function_local_static_prim;
+    }
+
 #if defined (__AVX__)
     
     VirtualCurveIntersector* VirtualCurveIntersector8i()
@@ -39,6 +39,8 @@ namespace embree
     
     typedef void (*Intersect16Ty)(void* pre, void* ray, size_t k, IntersectContext* context, const void* primitive);
     typedef bool (*Occluded16Ty) (void* pre, void* ray, size_t k, IntersectContext* context, const void* primitive);
+
+    typedef bool (*PointQuery1Ty)(PointQuery* query, PointQueryContext* context, const void* primitive);
     
   public:
     struct Intersectors
@@ -63,6 +65,7 @@ namespace embree
     };
     
     Intersectors vtbl[Geometry::GTY_END];
+    PointQuery1Ty pointQueries[Geometry::GTY_END]; //!< nullptr for primitive types without point query support
   };
 
   template<> __forceinline void VirtualCurveIntersector::Intersectors::intersect<1>(void* pre, void* ray, IntersectContext* context, const void* primitive) { assert(intersect1); intersect1(pre,ray,context,primitive); }
@@ -107,6 +110,18 @@ namespace embree
         VirtualCurveIntersector::Intersectors& leafIntersector = ((VirtualCurveIntersector*) This->leafIntersector)->vtbl[ty];
         return leafIntersector.occluded<1>(&pre,&ray,context,prim);
       }
+
+      /*! Point queries are not supported for curve geometries, but for the other primitives of unified leaves. */
+      template<int N>
+        static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t num, const TravPointQuery<N> &tquery, size_t& lazy_node)
+      {
+        assert(num == 1);
+        RTCGeometryType ty = (RTCGeometryType)(*prim);
+        assert(This->leafIntersector);
+        VirtualCurveIntersector::PointQuery1Ty pointQuery = ((VirtualCurveIntersector*) This->leafIntersector)->pointQueries[ty];
+        if (!pointQuery) return false;
+        return pointQuery(query,context,prim);
+      }
     };
 
     template<int K>
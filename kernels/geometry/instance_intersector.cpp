@@ -21,6 +21,83 @@ namespace embree
 {
   namespace isa
   {
+    /*! stores an affine transformation as 4x4 column major matrix */
+    static __forceinline void storeAffineSpace(float* M, const AffineSpace3fa& xfm)
+    {
+      M[ 0] = xfm.l.vx.x; M[ 1] = xfm.l.vx.y; M[ 2] = xfm.l.vx.z; M[ 3] = 0.0f;
+      M[ 4] = xfm.l.vy.x; M[ 5] = xfm.l.vy.y; M[ 6] = xfm.l.vy.z; M[ 7] = 0.0f;
+      M[ 8] = xfm.l.vz.x; M[ 9] = xfm.l.vz.y; M[10] = xfm.l.vz.z; M[11] = 0.0f;
+      M[12] = xfm.p.x;    M[13] = xfm.p.y;    M[14] = xfm.p.z;    M[15] = 1.0f;
+    }
+
+    /*! loads an affine transformation from a 4x4 column major matrix */
+    static __forceinline AffineSpace3fa loadAffineSpace(const float* M)
+    {
+      return AffineSpace3fa(Vec3fa(M[0],M[1],M[2]),Vec3fa(M[4],M[5],M[6]),Vec3fa(M[8],M[9],M[10]),Vec3fa(M[12],M[13],M[14]));
+    }
+
+    /*! returns the uniform scale of a similarity transformation, or 0 if the transformation is no similarity transformation */
+    static __forceinline float similarityScale(const LinearSpace3fa& l)
+    {
+      const float sx = dot(l.vx,l.vx), sy = dot(l.vy,l.vy), sz = dot(l.vz,l.vz);
+      const float eps = 1E-5f*max(sx,sy,sz);
+      if (abs(sx-sy) > eps || abs(sx-sz) > eps) return 0.0f;
+      if (abs(dot(l.vx,l.vy)) > eps || abs(dot(l.vx,l.vz)) > eps || abs(dot(l.vy,l.vz)) > eps) return 0.0f;
+      return sqrt(sx);
+    }
+
+    /*! performs the point query for the scene of some instance */
+    static bool pointQueryInstance(PointQuery* query, PointQueryContext* context, const Instance* instance, const AffineSpace3fa& local2world, const AffineSpace3fa& world2local)
+    {
+      RTCPointQueryContext* user_context = context->user;
+      const unsigned int level = user_context->instStackSize;
+      if (level >= RTC_MAX_INSTANCE_LEVEL_COUNT)
+        return false;
+
+      /* push the accumulated instance transformations onto the stack */
+      AffineSpace3fa world2inst = world2local;
+      AffineSpace3fa inst2world = local2world;
+      if (level > 0) {
+        world2inst = world2local * loadAffineSpace(user_context->world2inst[level-1]);
+        inst2world = loadAffineSpace(user_context->inst2world[level-1]) * local2world;
+      }
+      storeAffineSpace(user_context->world2inst[level],world2inst);
+      storeAffineSpace(user_context->inst2world[level],inst2world);
+      user_context->instID[level] = instance->geomID;
+      user_context->instStackSize++;
+
+      /* the query radius is scaled exactly for similarity transformations, and
+       * conservatively by the Frobenius norm of the transformation otherwise */
+      const float similarity_scale = similarityScale(world2inst.l);
+      const float radius_scale = similarity_scale > 0.0f ? similarity_scale
+        : sqrt(dot(world2inst.l.vx,world2inst.l.vx) + dot(world2inst.l.vy,world2inst.l.vy) + dot(world2inst.l.vz,world2inst.l.vz));
+
+      PointQuery query_inst;
+      query_inst.p = xfmPoint(world2inst,Vec3fa(context->query_ws->p));
+      query_inst.time = query->time;
+      query_inst.radius = context->query_ws->radius * radius_scale;
+
+      Scene* scene = context->scene;
+      const float parent_similarity_scale = context->similarityScale;
+      const float parent_radius_scale = context->queryRadiusScale;
+      context->scene = (Scene*)instance->object;
+      context->similarityScale = similarity_scale;
+      context->queryRadiusScale = radius_scale;
+      const bool changed = instance->object->intersectors.pointQuery(&query_inst,context);
+      context->scene = scene;
+      context->similarityScale = parent_similarity_scale;
+      context->queryRadiusScale = parent_radius_scale;
+
+      /* pop the instance stack */
+      user_context->instStackSize--;
+      user_context->instID[level] = RTC_INVALID_GEOMETRY_ID;
+
+      /* the radius of the parent query is derived from the shrunken world space radius */
+      if (changed)
+        query->radius = context->query_ws->radius * context->queryRadiusScale;
+      return changed;
+    }
+
     void InstanceIntersector1::intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const InstancePrimitive& prim)
     {
       const Instance* instance = prim.instance;
@@ -32,17 +109,20 @@ namespace embree
 #endif
 
       RTCIntersectContext* user_context = context->user;
-      const AffineSpace3fa world2local = instance->getWorld2Local();
-      const Vec3fa ray_org = ray.org;
-      const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
-      ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        STAT3(normal.trav_xfm_nodes,1,1,1);
+        const AffineSpace3fa world2local = instance->getWorld2Local();
+        const Vec3fa ray_org = ray.org;
+        const Vec3fa ray_dir = ray.dir;
+        ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+        ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
+        instance_id_stack::pop(user_context);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+      }
     }
     
     bool InstanceIntersector1::occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const InstancePrimitive& prim)
@@ -56,20 +136,29 @@ namespace embree
 #endif
       
       RTCIntersectContext* user_context = context->user;
-      const AffineSpace3fa world2local = instance->getWorld2Local();
-      const Vec3fa ray_org = ray.org;
-      const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
-      ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        STAT3(shadow.trav_xfm_nodes,1,1,1);
+        const AffineSpace3fa world2local = instance->getWorld2Local();
+        const Vec3fa ray_org = ray.org;
+        const Vec3fa ray_dir = ray.dir;
+        ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+        ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
+        instance_id_stack::pop(user_context);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+      }
       return ray.tfar < 0.0f;
     }
 
+    bool InstanceIntersector1::pointQuery(PointQuery* query, PointQueryContext* context, const InstancePrimitive& prim)
+    {
+      const Instance* instance = prim.instance;
+      return pointQueryInstance(query,context,instance,instance->getLocal2World(),instance->getWorld2Local());
+    }
+
     void InstanceIntersector1MB::intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const InstancePrimitive& prim)
     {
       const Instance* instance = prim.instance;
@@ -81,17 +170,20 @@ namespace embree
 #endif
       
       RTCIntersectContext* user_context = context->user;
-      const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
-      const Vec3fa ray_org = ray.org;
-      const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
-      ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        STAT3(normal.trav_xfm_nodes,1,1,1);
+        const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
+        const Vec3fa ray_org = ray.org;
+        const Vec3fa ray_dir = ray.dir;
+        ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+        ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
+        instance_id_stack::pop(user_context);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+      }
     }
     
     bool InstanceIntersector1MB::occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const InstancePrimitive& prim)
@@ -105,19 +197,29 @@ namespace embree
 #endif
       
       RTCIntersectContext* user_context = context->user;
-      const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
-      const Vec3fa ray_org = ray.org;
-      const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
-      ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        STAT3(shadow.trav_xfm_nodes,1,1,1);
+        const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
+        const Vec3fa ray_org = ray.org;
+        const Vec3fa ray_dir = ray.dir;
+        ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+        ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
+        instance_id_stack::pop(user_context);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+      }
       return ray.tfar < 0.0f;
     }
+
+    bool InstanceIntersector1MB::pointQuery(PointQuery* query, PointQueryContext* context, const InstancePrimitive& prim)
+    {
+      const Instance* instance = prim.instance;
+      const AffineSpace3fa local2world = instance->getLocal2World(query->time);
+      return pointQueryInstance(query,context,instance,local2world,rcp(local2world));
+    }
     
     template<int K>
     void InstanceIntersectorK<K>::intersect(const vbool<K>& valid_i, const Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const InstancePrimitive& prim)
@@ -132,17 +234,20 @@ namespace embree
 #endif
         
       RTCIntersectContext* user_context = context->user;
-      AffineSpace3vf<K> world2local = instance->getWorld2Local();
-      const Vec3vf<K> ray_org = ray.org;
-      const Vec3vf<K> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        STAT3(normal.trav_xfm_nodes,1,popcnt(valid),K);
+        AffineSpace3vf<K> world2local = instance->getWorld2Local();
+        const Vec3vf<K> ray_org = ray.org;
+        const Vec3vf<K> ray_dir = ray.dir;
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.intersect(valid,ray,&newcontext);
+        instance_id_stack::pop(user_context);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+      }
     }
 
     template<int K>
@@ -158,17 +263,20 @@ namespace embree
 #endif
         
       RTCIntersectContext* user_context = context->user;
-      AffineSpace3vf<K> world2local = instance->getWorld2Local();
-      const Vec3vf<K> ray_org = ray.org;
-      const Vec3vf<K> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        STAT3(shadow.trav_xfm_nodes,1,popcnt(valid),K);
+        AffineSpace3vf<K> world2local = instance->getWorld2Local();
+        const Vec3vf<K> ray_org = ray.org;
+        const Vec3vf<K> ray_dir = ray.dir;
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded(valid,ray,&newcontext);
+        instance_id_stack::pop(user_context);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+      }
       return ray.tfar < 0.0f;
     }
 
@@ -185,17 +293,20 @@ namespace embree
 #endif
         
       RTCIntersectContext* user_context = context->user;
-      AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid,ray.time());
-      const Vec3vf<K> ray_org = ray.org;
-      const Vec3vf<K> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        STAT3(normal.trav_xfm_nodes,1,popcnt(valid),K);
+        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid,ray.time());
+        const Vec3vf<K> ray_org = ray.org;
+        const Vec3vf<K> ray_dir = ray.dir;
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.intersect(valid,ray,&newcontext);
+        instance_id_stack::pop(user_context);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+      }
     }
 
     template<int K>
@@ -211,17 +322,20 @@ namespace embree
 #endif
         
       RTCIntersectContext* user_context = context->user;
-      AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid,ray.time());
-      const Vec3vf<K> ray_org = ray.org;
-      const Vec3vf<K> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        STAT3(shadow.trav_xfm_nodes,1,popcnt(valid),K);
+        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid,ray.time());
+        const Vec3vf<K> ray_org = ray.org;
+        const Vec3vf<K> ray_dir = ray.dir;
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded(valid,ray,&newcontext);
+        instance_id_stack::pop(user_context);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+      }
       return ray.tfar < 0.0f;
     }
 
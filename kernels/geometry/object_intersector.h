@@ -18,6 +18,7 @@
 
 #include "object.h"
 #include "../common/ray.h"
+#include "../common/point_query.h"
 
 namespace embree
 {
@@ -60,6 +61,11 @@ namespace embree
         accel->occluded(ray,prim.primID(),context,&reportOcclusion1);
         return ray.tfar < 0.0f;
       }
+
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return context->callback(query,prim.geomID(),prim.primID());
+      }
       
       template<int K>
       static __forceinline void intersectK(const vbool<K>& valid, /* PrecalculationsK& pre, */ RayHitK<K>& ray, IntersectContext* context, const Primitive* prim, size_t num, size_t& lazy_node)
@@ -19,16 +19,19 @@
 #include "curveNi.h"
 #include "curveNi_mb.h"
 #include "linei.h"
+#include "pointi.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglev_mb.h"
 #include "trianglei.h"
+#include "triangleq.h"
 #include "quadv.h"
 #include "quadi.h"
 #include "subdivpatch1.h"
 #include "object.h"
 #include "instance.h"
 #include "subgrid.h"
+#include "unified.h"
 
 namespace embree
 {
@@ -222,6 +225,28 @@ namespace embree
     return sizeof(Triangle4i);
   }
 
+  /********************** Triangle4q **************************/
+
+  template<>
+  const char* Triangle4q::Type::name () const {
+    return "triangle4q";
+  }
+
+  template<>
+  size_t Triangle4q::Type::sizeActive(const char* This) const {
+    return ((Triangle4q*)This)->size();
+  }
+
+  template<>
+  size_t Triangle4q::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t Triangle4q::Type::getBytes(const char* This) const {
+    return sizeof(Triangle4q);
+  }
+
   /********************** Triangle4vMB **************************/
 
   template<>
@@ -348,6 +373,59 @@ namespace embree
 
   InstancePrimitive::Type InstancePrimitive::type;
 
+  /********************** Unified **************************/
+
+  const char* UnifiedLeaf::Type::name () const {
+    return "unified4";
+  }
+
+  size_t UnifiedLeaf::Type::sizeActive(const char* This) const
+  {
+    const UnifiedLeaf* leaf = (const UnifiedLeaf*) This;
+    switch (leaf->ty) {
+    case Geometry::GTY_TRIANGLE_MESH: return Triangle4v::type.sizeActive((const char*)&leaf->block<Triangle4v>(0));
+    case Geometry::GTY_QUAD_MESH    : return Quad4v::type.sizeActive((const char*)&leaf->block<Quad4v>(0));
+    case Geometry::GTY_USER_GEOMETRY: return leaf->size();
+    case Geometry::GTY_INSTANCE     : return leaf->size();
+    case Geometry::GTY_SPHERE_POINT:
+    case Geometry::GTY_DISC_POINT:
+    case Geometry::GTY_ORIENTED_DISC_POINT: return ((Point4i*)This)->size();
+    default: return Curve4i::type.sizeActive(This);
+    }
+  }
+
+  size_t UnifiedLeaf::Type::sizeTotal(const char* This) const
+  {
+    const UnifiedLeaf* leaf = (const UnifiedLeaf*) This;
+    switch (leaf->ty) {
+    case Geometry::GTY_TRIANGLE_MESH: return 4;
+    case Geometry::GTY_QUAD_MESH    : return 4;
+    case Geometry::GTY_USER_GEOMETRY: return leaf->size();
+    case Geometry::GTY_INSTANCE     : return leaf->size();
+    case Geometry::GTY_SPHERE_POINT:
+    case Geometry::GTY_DISC_POINT:
+    case Geometry::GTY_ORIENTED_DISC_POINT: return 4;
+    default: return Curve4i::type.sizeTotal(This);
+    }
+  }
+
+  size_t UnifiedLeaf::Type::getBytes(const char* This) const
+  {
+    const UnifiedLeaf* leaf = (const UnifiedLeaf*) This;
+    switch (leaf->ty) {
+    case Geometry::GTY_TRIANGLE_MESH: return UnifiedLeaf::headerBytes+leaf->size()*sizeof(Triangle4v);
+    case Geometry::GTY_QUAD_MESH    : return UnifiedLeaf::headerBytes+leaf->size()*sizeof(Quad4v);
+    case Geometry::GTY_USER_GEOMETRY: return UnifiedLeaf::headerBytes+leaf->size()*sizeof(Object);
+    case Geometry::GTY_INSTANCE     : return UnifiedLeaf::headerBytes+leaf->size()*sizeof(InstancePrimitive);
+    case Geometry::GTY_SPHERE_POINT:
+    case Geometry::GTY_DISC_POINT:
+    case Geometry::GTY_ORIENTED_DISC_POINT: return Point4i::bytes(((Point4i*)This)->size());
+    default: return Curve4i::type.getBytes(This);
+    }
+  }
+
+  UnifiedLeaf::Type UnifiedLeaf::type;
+
   /********************** SubGrid **************************/
 
   const char* SubGrid::Type::name () const {
@@ -389,4 +467,26 @@ namespace embree
   size_t SubGridQBVH4::Type::getBytes(const char* This) const {
     return sizeof(SubGridQBVH4);
   }
+
+  /********************** SubGridMBQBVH4 **************************/
+
+  template<>
+  const char* SubGridMBQBVH4::Type::name () const {
+    return "SubGridMBQBVH4";
+  }
+
+  template<>
+  size_t SubGridMBQBVH4::Type::sizeActive(const char* This) const {
+    return 1;
+  }
+
+  template<>
+  size_t SubGridMBQBVH4::Type::sizeTotal(const char* This) const {
+    return 1;
+  }
+
+  template<>
+  size_t SubGridMBQBVH4::Type::getBytes(const char* This) const {
+    return sizeof(SubGridMBQBVH4);
+  }
 }
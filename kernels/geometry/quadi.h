@@ -79,9 +79,13 @@ namespace embree
     __forceinline const vuint<M>& primID() const { return primIDs; }
     __forceinline unsigned int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
 
-    __forceinline Vec3f& getVertex(const vuint<M>& v, const size_t index, const Scene *const scene) const
+    __forceinline Vec3f getVertex(const vuint<M>& v, const size_t index, const Scene *const scene) const
     {
       const float* vertices = scene->vertices[geomID(index)];
+      if (unlikely(scene->hasHalfVertices())) {
+        const Vec3fa p = scene->get<QuadMesh>(geomID(index))->loadVertex(vertices+v[index]);
+        return Vec3f(p.x,p.y,p.z);
+      }
       return (Vec3f&) vertices[v[index]];
     }
 
@@ -91,8 +95,8 @@ namespace embree
       const QuadMesh* mesh = scene->get<QuadMesh>(geomID(index));
       const float* vertices0 = (const float*) mesh->vertexPtr(0,itime+0);
       const float* vertices1 = (const float*) mesh->vertexPtr(0,itime+1);
-      const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-      const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+      const Vec3fa v0 = mesh->loadVertex(vertices0+v[index]);
+      const Vec3fa v1 = mesh->loadVertex(vertices1+v[index]);
       const Vec3<T> p0(v0.x,v0.y,v0.z);
       const Vec3<T> p1(v1.x,v1.y,v1.z);
       return lerp(p0,p1,ftime);
@@ -108,8 +112,8 @@ namespace embree
       {
         const float* vertices0 = (const float*) mesh->vertexPtr(0,itime[i]+0);
         const float* vertices1 = (const float*) mesh->vertexPtr(0,itime[i]+1);
-        const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-        const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+        const Vec3fa v0 = mesh->loadVertex(vertices0+v[index]);
+        const Vec3fa v1 = mesh->loadVertex(vertices1+v[index]);
         p0.x[i] = v0.x; p0.y[i] = v0.y; p0.z[i] = v0.z;
         p1.x[i] = v1.x; p1.y[i] = v1.y; p1.z[i] = v1.z;
       }
@@ -183,11 +187,12 @@ namespace embree
       BBox3fa bounds = empty;
       for (size_t i=0; i<M && valid(i); i++)
       {
-        const float* vertices = (const float*) scene->get<QuadMesh>(geomID(i))->vertexPtr(0,itime);
-        bounds.extend(Vec3fa::loadu(vertices+v0[i]));
-        bounds.extend(Vec3fa::loadu(vertices+v1[i]));
-        bounds.extend(Vec3fa::loadu(vertices+v2[i]));
-        bounds.extend(Vec3fa::loadu(vertices+v3[i]));
+        const QuadMesh* mesh = scene->get<QuadMesh>(geomID(i));
+        const float* vertices = (const float*) mesh->vertexPtr(0,itime);
+        bounds.extend(mesh->loadVertex(vertices+v0[i]));
+        bounds.extend(mesh->loadVertex(vertices+v1[i]));
+        bounds.extend(mesh->loadVertex(vertices+v2[i]));
+        bounds.extend(mesh->loadVertex(vertices+v3[i]));
       }
       return bounds;
     }
@@ -312,6 +317,26 @@ namespace embree
   {
     prefetchL1(((char*)this)+0*64);
     prefetchL1(((char*)this)+1*64);
+
+    /* half precision vertices are converted one by one */
+    if (unlikely(scene->hasHalfVertices()))
+    {
+      for (size_t i=0; i<4; i++)
+      {
+        const QuadMesh* mesh = scene->get<QuadMesh>(geomID(i));
+        const float* vertices = scene->vertices[geomID(i)];
+        const Vec3fa a = mesh->loadVertex(vertices + v0[i]);
+        const Vec3fa b = mesh->loadVertex(vertices + v1[i]);
+        const Vec3fa c = mesh->loadVertex(vertices + v2[i]);
+        const Vec3fa d = mesh->loadVertex(vertices + v3[i]);
+        p0.x[i] = a.x; p0.y[i] = a.y; p0.z[i] = a.z;
+        p1.x[i] = b.x; p1.y[i] = b.y; p1.z[i] = b.z;
+        p2.x[i] = c.x; p2.y[i] = c.y; p2.z[i] = c.z;
+        p3.x[i] = d.x; p3.y[i] = d.y; p3.z[i] = d.z;
+      }
+      return;
+    }
+
     const float* vertices0 = scene->vertices[geomID(0)];
     const float* vertices1 = scene->vertices[geomID(1)];
     const float* vertices2 = scene->vertices[geomID(2)];
@@ -346,6 +371,16 @@ namespace embree
                                        Vec3vf16& p3,
                                        const Scene *const scene) const // FIXME: why do we have this special path here and not for triangles?
   {
+    if (unlikely(scene->hasHalfVertices()))
+    {
+      Vec3vf4 a,b,c,d; gather(a,b,c,d,scene);
+      p0 = Vec3vf16(vfloat16(a.x),vfloat16(a.y),vfloat16(a.z));
+      p1 = Vec3vf16(vfloat16(b.x),vfloat16(b.y),vfloat16(b.z));
+      p2 = Vec3vf16(vfloat16(c.x),vfloat16(c.y),vfloat16(c.z));
+      p3 = Vec3vf16(vfloat16(d.x),vfloat16(d.y),vfloat16(d.z));
+      return;
+    }
+
     const vint16 perm(0,4,8,12,1,5,9,13,2,6,10,14,3,7,11,15);
     const float* vertices0 = scene->vertices[geomID(0)];
     const float* vertices1 = scene->vertices[geomID(1)];
@@ -406,6 +441,22 @@ namespace embree
     const float* vertices1 = (const float*) mesh->vertexPtr(0,itime);
     const float* vertices2 = (const float*) mesh->vertexPtr(0,itime);
     const float* vertices3 = (const float*) mesh->vertexPtr(0,itime);
+    if (unlikely(mesh->hasHalfVertices()))
+    {
+      for (size_t i=0; i<4; i++)
+      {
+        const Vec3fa a = mesh->loadVertex(vertices0 + v0[i]);
+        const Vec3fa b = mesh->loadVertex(vertices0 + v1[i]);
+        const Vec3fa c = mesh->loadVertex(vertices0 + v2[i]);
+        const Vec3fa d = mesh->loadVertex(vertices0 + v3[i]);
+        p0.x[i] = a.x; p0.y[i] = a.y; p0.z[i] = a.z;
+        p1.x[i] = b.x; p1.y[i] = b.y; p1.z[i] = b.z;
+        p2.x[i] = c.x; p2.y[i] = c.y; p2.z[i] = c.z;
+        p3.x[i] = d.x; p3.y[i] = d.y; p3.z[i] = d.z;
+      }
+      return;
+    }
+
     const vfloat4 a0 = vfloat4::loadu(vertices0 + v0[0]);
     const vfloat4 a1 = vfloat4::loadu(vertices1 + v0[1]);
     const vfloat4 a2 = vfloat4::loadu(vertices2 + v0[2]);
@@ -46,6 +46,12 @@ namespace embree
         Vec3vf<M> v0,v1,v2,v3; quad.gather(v0,v1,v2,v3,context->scene);
         return pre.occluded(ray,context,v0,v1,v2,v3,quad.geomID(),quad.primID());
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M triangles with K rays. */
@@ -129,6 +135,12 @@ namespace embree
         Vec3vf<M> v0,v1,v2,v3; quad.gather(v0,v1,v2,v3,context->scene);
         return pre.occluded(ray,context,v0,v1,v2,v3,quad.geomID(),quad.primID());
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M triangles with K rays. */
@@ -212,6 +224,12 @@ namespace embree
         Vec3vf<M> v0,v1,v2,v3; quad.gather(v0,v1,v2,v3,context->scene,ray.time());
         return pre.occluded(ray,context,v0,v1,v2,v3,quad.geomID(),quad.primID());
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M motion blur quads with K rays. */
@@ -287,6 +305,12 @@ namespace embree
         Vec3vf<M> v0,v1,v2,v3; quad.gather(v0,v1,v2,v3,context->scene,ray.time());
         return pre.occluded(ray,context,v0,v1,v2,v3,quad.geomID(),quad.primID());
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M motion blur quads with K rays. */
@@ -44,6 +44,12 @@ namespace embree
         STAT3(shadow.trav_prims,1,1,1);
         return pre.occluded(ray,context, quad.v0,quad.v1,quad.v2,quad.v3,quad.geomID(),quad.primID());
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M triangles with K rays. */
@@ -122,6 +128,12 @@ namespace embree
         STAT3(shadow.trav_prims,1,1,1);
         return pre.occluded(ray,context, quad.v0,quad.v1,quad.v2,quad.v3,quad.geomID(),quad.primID());
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M triangles with K rays. */
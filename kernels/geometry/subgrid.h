@@ -527,4 +527,10 @@ namespace embree
 
       };
 
+      template<int N>
+        typename SubGridMBQBVHN<N>::Type SubGridMBQBVHN<N>::type;
+
+      typedef SubGridMBQBVHN<4> SubGridMBQBVH4;
+      typedef SubGridMBQBVHN<8> SubGridMBQBVH8;
+
 }
@@ -99,6 +99,22 @@ namespace embree
         }
         return false;
       }
+
+      static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t num, const TravPointQuery<N> &tquery, size_t& lazy_node)
+      {
+        bool changed = false;
+        for (size_t i=0;i<num;i++)
+        {
+          vfloat<N> dist;
+          size_t mask = pointQueryNode<N>(&prim[i].qnode,tquery,dist);
+          while(mask != 0)
+          {
+            const size_t ID = bscf(mask);
+            changed |= context->callback(query,prim[i].geomID(),prim[i].primID(ID));
+          }
+        }
+        return changed;
+      }
     };
 
 
@@ -172,6 +188,22 @@ namespace embree
         }
         return false;
       }
+
+      static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t num, const TravPointQuery<N> &tquery, size_t& lazy_node)
+      {
+        bool changed = false;
+        for (size_t i=0;i<num;i++)
+        {
+          vfloat<N> dist;
+          size_t mask = pointQueryNode<N>(&prim[i].qnode,tquery,dist);
+          while(mask != 0)
+          {
+            const size_t ID = bscf(mask);
+            changed |= context->callback(query,prim[i].geomID(),prim[i].primID(ID));
+          }
+        }
+        return changed;
+      }
     };
 
 
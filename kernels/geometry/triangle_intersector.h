@@ -43,6 +43,12 @@ namespace embree
         STAT3(shadow.trav_prims,1,1,1);
         return pre.intersectEdge(ray,tri.v0,tri.e1,tri.e2,Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID()));
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
 #if defined(__AVX__)
@@ -67,6 +73,12 @@ namespace embree
         STAT3(shadow.trav_prims,1,1,1);
         return pre.intersect(ray,tri.v0,tri.e1,tri.e2,Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID()));
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 #endif
 
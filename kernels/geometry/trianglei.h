@@ -77,9 +77,13 @@ namespace embree
     __forceinline unsigned int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
 
     /* loads a single vertex */
-    __forceinline Vec3f& getVertex(const vuint<M>& v, const size_t index, const Scene *const scene) const
+    __forceinline Vec3f getVertex(const vuint<M>& v, const size_t index, const Scene *const scene) const
     {
       const float* vertices = scene->vertices[geomID(index)];
+      if (unlikely(scene->hasHalfVertices())) {
+        const Vec3fa p = scene->get<TriangleMesh>(geomID(index))->loadVertex(vertices+v[index]);
+        return Vec3f(p.x,p.y,p.z);
+      }
       return (Vec3f&) vertices[v[index]];
     }
 
@@ -89,8 +93,8 @@ namespace embree
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
       const float* vertices0 = (const float*) mesh->vertexPtr(0,itime+0);
       const float* vertices1 = (const float*) mesh->vertexPtr(0,itime+1);
-      const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-      const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+      const Vec3fa v0 = mesh->loadVertex(vertices0+v[index]);
+      const Vec3fa v1 = mesh->loadVertex(vertices1+v[index]);
       const Vec3<T> p0(v0.x,v0.y,v0.z);
       const Vec3<T> p1(v1.x,v1.y,v1.z);
       return lerp(p0,p1,ftime);
@@ -106,8 +110,8 @@ namespace embree
       {
         const float* vertices0 = (const float*) mesh->vertexPtr(0,itime[i]+0);
         const float* vertices1 = (const float*) mesh->vertexPtr(0,itime[i]+1);
-        const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-        const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+        const Vec3fa v0 = mesh->loadVertex(vertices0+v[index]);
+        const Vec3fa v1 = mesh->loadVertex(vertices1+v[index]);
         p0.x[i] = v0.x; p0.y[i] = v0.y; p0.z[i] = v0.z;
         p1.x[i] = v1.x; p1.y[i] = v1.y; p1.z[i] = v1.z;
       }
@@ -162,10 +166,11 @@ namespace embree
       BBox3fa bounds = empty;
       for (size_t i=0; i<M && valid(i); i++)
       {
-        const float* vertices = (const float*) scene->get<TriangleMesh>(geomID(i))->vertexPtr(0,itime);
-        bounds.extend(Vec3fa::loadu(vertices+v0[i]));
-        bounds.extend(Vec3fa::loadu(vertices+v1[i]));
-        bounds.extend(Vec3fa::loadu(vertices+v2[i]));
+        const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(i));
+        const float* vertices = (const float*) mesh->vertexPtr(0,itime);
+        bounds.extend(mesh->loadVertex(vertices+v0[i]));
+        bounds.extend(mesh->loadVertex(vertices+v1[i]));
+        bounds.extend(mesh->loadVertex(vertices+v2[i]));
       }
       return bounds;
     }
@@ -287,6 +292,23 @@ namespace embree
                                            Vec3vf4& p2,
                                            const Scene* const scene) const
   {
+    /* half precision vertices are converted one by one */
+    if (unlikely(scene->hasHalfVertices()))
+    {
+      for (size_t i=0; i<4; i++)
+      {
+        const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(i));
+        const float* vertices = scene->vertices[geomID(i)];
+        const Vec3fa a = mesh->loadVertex(vertices + v0[i]);
+        const Vec3fa b = mesh->loadVertex(vertices + v1[i]);
+        const Vec3fa c = mesh->loadVertex(vertices + v2[i]);
+        p0.x[i] = a.x; p0.y[i] = a.y; p0.z[i] = a.z;
+        p1.x[i] = b.x; p1.y[i] = b.y; p1.z[i] = b.z;
+        p2.x[i] = c.x; p2.y[i] = c.y; p2.z[i] = c.z;
+      }
+      return;
+    }
+
     const float* vertices0 = scene->vertices[geomID(0)];
     const float* vertices1 = scene->vertices[geomID(1)];
     const float* vertices2 = scene->vertices[geomID(2)];
@@ -316,6 +338,20 @@ namespace embree
                                            const int itime) const
   {
     const float* vertices = (const float*) mesh->vertexPtr(0,itime);
+    if (unlikely(mesh->hasHalfVertices()))
+    {
+      for (size_t i=0; i<4; i++)
+      {
+        const Vec3fa a = mesh->loadVertex(vertices + v0[i]);
+        const Vec3fa b = mesh->loadVertex(vertices + v1[i]);
+        const Vec3fa c = mesh->loadVertex(vertices + v2[i]);
+        p0.x[i] = a.x; p0.y[i] = a.y; p0.z[i] = a.z;
+        p1.x[i] = b.x; p1.y[i] = b.y; p1.z[i] = b.z;
+        p2.x[i] = c.x; p2.y[i] = c.y; p2.z[i] = c.z;
+      }
+      return;
+    }
+
     const vfloat4 a0 = vfloat4::loadu(vertices + v0[0]);
     const vfloat4 a1 = vfloat4::loadu(vertices + v0[1]);
     const vfloat4 a2 = vfloat4::loadu(vertices + v0[2]);
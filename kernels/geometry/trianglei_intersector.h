@@ -44,6 +44,12 @@ namespace embree
         Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2,context->scene);
         return pre.intersect(ray,v0,v1,v2,/*UVIdentity<Mx>(),*/Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID()));
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M triangles with K rays */
@@ -120,6 +126,12 @@ namespace embree
         Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2,context->scene);
         return pre.intersect(ray,v0,v1,v2,UVIdentity<Mx>(),Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID()));
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M triangles with K rays */
@@ -198,6 +210,12 @@ namespace embree
         Vec3vf<M> v0,v1,v2; tri.gather(v0,v1,v2,context->scene,ray.time());
         return pre.intersect(ray,v0,v1,v2,/*UVIdentity<Mx>(),*/Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID()));
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M motion blur triangles with K rays. */
@@ -273,6 +291,12 @@ namespace embree
         Vec3vf<M> v0,v1,v2; tri.gather(v0,v1,v2,context->scene,ray.time());
         return pre.intersect(ray,v0,v1,v2,UVIdentity<Mx>(),Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomID(),tri.primID()));
       }
+
+      /*! Calls the point query callback for the M primitives. */
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query,context,prim);
+      }
     };
 
     /*! Intersects M motion blur triangles with K rays. */
@@ -0,0 +1,251 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores up to M triangles of the same mesh in compressed form. The
+   * vertices are shared between the triangles through 8 bit indices
+   * into a small vertex table, and are quantized to 16 bit relative to
+   * the bounds of the stored triangles. */
+  template <int M>
+  struct TriangleMq
+  { 
+  public:
+    struct Type : public PrimitiveType 
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+    /* maximal number of vertices that can get stored */
+    static const size_t V = 7;
+
+  public:
+
+    /* Returns maximum number of stored triangles */
+    static __forceinline size_t max_size() { return M; }
+    
+    /* Returns estimated number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+    /* Returns the exact number of primitive blocks required to store some range of primitives */
+    static __forceinline size_t blocks(const PrimRef* prims, size_t begin, size_t end, Scene* scene)
+    {
+      size_t n = 0;
+      for (; begin<end; n++) begin += numFitting(prims,begin,end,scene);
+      return n;
+    }
+
+  private:
+
+    /* Returns the number of triangles starting at begin that fit into one block */
+    static __forceinline size_t numFitting(const PrimRef* prims, size_t begin, size_t end, Scene* scene)
+    {
+      const unsigned geomID0 = prims[begin].geomID();
+      const TriangleMesh* __restrict__ const mesh = scene->get<TriangleMesh>(geomID0);
+      
+      unsigned vertices[V]; size_t numVertices = 0;
+      unsigned minPrimID = prims[begin].primID(), maxPrimID = minPrimID;
+      size_t i=0;
+      for (; i<M && begin+i<end; i++)
+      {
+        /* all triangles have to be of the same mesh and the primitive IDs have to fit into 16 bit offsets */
+        const PrimRef& prim = prims[begin+i];
+        if (prim.geomID() != geomID0) break;
+        if (max(maxPrimID,prim.primID())-min(minPrimID,prim.primID()) > 0xFFFF) break;
+        
+        const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
+        size_t numNew = 0; unsigned newVertices[3];
+        for (size_t k=0; k<3; k++) {
+          if (findVertex(vertices,numVertices,tri.v[k]) != V) continue;
+          if (findVertex(newVertices,numNew,tri.v[k]) != V) continue;
+          newVertices[numNew++] = tri.v[k];
+        }
+        if (numVertices+numNew > V) break;
+        minPrimID = min(minPrimID,prim.primID());
+        maxPrimID = max(maxPrimID,prim.primID());
+        for (size_t k=0; k<numNew; k++) vertices[numVertices++] = newVertices[k];
+      }
+      return i;
+    }
+
+    /* Returns the slot of some vertex in a vertex table or V if not found */
+    static __forceinline size_t findVertex(const unsigned* vertices, size_t numVertices, unsigned v)
+    {
+      for (size_t i=0; i<numVertices; i++)
+        if (vertices[i] == v) return i;
+      return V;
+    }
+   
+  public:
+
+    /* Default constructor */
+    __forceinline TriangleMq() {}
+    
+    /* Returns a mask that tells which triangles are valid */
+    __forceinline vbool<M> valid() const { return vint<M>(step) < vint<M>(int(num)); }
+
+    /* Returns true if the specified triangle is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return i < num; }
+
+    /* Returns the number of stored triangles */
+    __forceinline size_t size() const { return num; }
+
+    /* Returns the geometry IDs */
+    __forceinline vuint<M> geomID() const { return vuint<M>(geomID0); }
+    __forceinline unsigned int geomID(const size_t i) const { assert(i<M); return geomID0; }
+
+    /* Returns the primitive IDs */
+    __forceinline vuint<M> primID() const 
+    {
+      vuint<M> primIDs;
+      for (size_t i=0; i<M; i++) primIDs[i] = primID(i);
+      return primIDs;
+    }
+    __forceinline unsigned int primID(const size_t i) const { assert(i<M); return primID0+primIDOffsets[i]; }
+
+    /* Decodes a vertex of the vertex table */
+    __forceinline Vec3f vertex(const size_t i) const
+    {
+      assert(i<numVertices);
+      return Vec3f(madd(scale.x,float(vx[i]),lower.x),
+                    madd(scale.y,float(vy[i]),lower.y),
+                    madd(scale.z,float(vz[i]),lower.z));
+    }
+
+    /* Returns the vertices of the i'th triangle */
+    __forceinline Vec3f getVertex0(const size_t i) const { return vertex(v0[i]); }
+    __forceinline Vec3f getVertex1(const size_t i) const { return vertex(v1[i]); }
+    __forceinline Vec3f getVertex2(const size_t i) const { return vertex(v2[i]); }
+
+    /* Decodes the vertices of all triangles, invalid triangles get degenerated */
+    __forceinline void gather(Vec3vf<M>& p0, Vec3vf<M>& p1, Vec3vf<M>& p2) const
+    {
+      Vec3f vtx[V];
+      for (size_t i=0; i<numVertices; i++)
+        vtx[i] = vertex(i);
+
+      p0 = p1 = p2 = Vec3vf<M>(zero);
+      for (size_t i=0; i<num; i++)
+      {
+        const Vec3f& a = vtx[v0[i]]; p0.x[i] = a.x; p0.y[i] = a.y; p0.z[i] = a.z;
+        const Vec3f& b = vtx[v1[i]]; p1.x[i] = b.x; p1.y[i] = b.y; p1.z[i] = b.z;
+        const Vec3f& c = vtx[v2[i]]; p2.x[i] = c.x; p2.y[i] = c.y; p2.z[i] = c.z;
+      }
+    }
+
+    /* Calculate the bounds of the triangles */
+    __forceinline BBox3fa bounds() const 
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<numVertices; i++) {
+        const Vec3f v = vertex(i);
+        bounds.extend(Vec3fa(v.x,v.y,v.z));
+      }
+      return bounds;
+    }
+
+    /* Fill block from triangle list, stores as many triangles as fit into the block */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene)
+    {
+      const size_t n = numFitting(prims,begin,end,scene);
+      assert(n >= 1);
+      geomID0 = prims[begin].geomID();
+      primID0 = prims[begin].primID();
+      for (size_t i=1; i<n; i++)
+        primID0 = min(primID0,prims[begin+i].primID());
+      const TriangleMesh* __restrict__ const mesh = scene->get<TriangleMesh>(geomID0);
+
+      /* build shared vertex table */
+      unsigned vertices[V]; size_t nv = 0;
+      unsigned char* indices[3] = { v0, v1, v2 };
+      for (size_t i=0; i<M; i++)
+      {
+        primIDOffsets[i] = 0;
+        v0[i] = v1[i] = v2[i] = 0;
+        if (i >= n) continue;
+        
+        const unsigned primID = prims[begin+i].primID();
+        primIDOffsets[i] = (unsigned short) (primID-primID0);
+        const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+        for (size_t k=0; k<3; k++)
+        {
+          size_t slot = findVertex(vertices,nv,tri.v[k]);
+          if (slot == V) { slot = nv; vertices[nv++] = tri.v[k]; }
+          indices[k][i] = (unsigned char) slot;
+        }
+      }
+      num = (unsigned char) n;
+      numVertices = (unsigned char) nv;
+      begin += n;
+
+      /* quantize vertices relative to their bounds */
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<nv; i++)
+        bounds.extend(mesh->vertex(vertices[i]));
+      const Vec3fa diag = bounds.size();
+      lower = Vec3f(bounds.lower.x,bounds.lower.y,bounds.lower.z);
+      scale = Vec3f(diag.x/65535.0f,diag.y/65535.0f,diag.z/65535.0f);
+      const Vec3fa rcp_scale = Vec3fa(quantize_rcp(scale.x),quantize_rcp(scale.y),quantize_rcp(scale.z));
+      
+      for (size_t i=0; i<V; i++)
+      {
+        if (i >= nv) { vx[i] = vy[i] = vz[i] = 0; continue; }
+        const Vec3fa q = (mesh->vertex(vertices[i])-bounds.lower)*rcp_scale;
+        vx[i] = quantize(q.x);
+        vy[i] = quantize(q.y);
+        vz[i] = quantize(q.z);
+      }
+    }
+
+  private:
+
+    static __forceinline float quantize_rcp(float s) {
+      return s > 0.0f ? 1.0f/s : 0.0f;
+    }
+
+    static __forceinline unsigned short quantize(float q) {
+      return (unsigned short) clamp(floorf(q+0.5f),0.0f,65535.0f);
+    }
+
+  public:
+    Vec3f lower;                     // origin of the quantization grid
+    unsigned geomID0;                // geometry ID of all triangles
+    Vec3f scale;                     // extent of one quantization step
+    unsigned primID0;                // smallest primitive ID of the triangles
+    unsigned short primIDOffsets[M]; // primitive IDs relative to primID0
+    unsigned char v0[M];             // index of 1st vertex of the triangles
+    unsigned char v1[M];             // index of 2nd vertex of the triangles
+    unsigned char v2[M];             // index of 3rd vertex of the triangles
+    unsigned char num;               // number of stored triangles
+    unsigned char numVertices;       // number of stored vertices
+    unsigned short vx[V];            // quantized x coordinates of the vertices
+    unsigned short vy[V];            // quantized y coordinates of the vertices
+    unsigned short vz[V];            // quantized z coordinates of the vertices
+  };
+
+  template<int M>
+  typename TriangleMq<M>::Type TriangleMq<M>::type;
+
+  typedef TriangleMq<4> Triangle4q;
+}
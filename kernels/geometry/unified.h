@@ -0,0 +1,79 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /*! Leaf of the unified BVH that stores primitive blocks of a type
+   *  that does not encode its geometry type itself. The geometry type
+   *  is stored in the first byte, like for curve leaves, such that the
+   *  virtual leaf intersector can dispatch on it. */
+  struct UnifiedLeaf
+  {
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+    /* number of header bytes, keeps primitive blocks 16 byte aligned */
+    static const size_t headerBytes = 16;
+
+  public:
+
+    /* returns the number of stored primitive blocks */
+    __forceinline size_t size() const {
+      return N;
+    }
+
+    /* returns the i'th primitive block */
+    template<typename Primitive>
+    __forceinline const Primitive& block(size_t i) const
+    {
+      assert(i < N);
+      return ((const Primitive*)((const char*)this + headerBytes))[i];
+    }
+
+    /* creates a leaf for the primitives of the specified range */
+    template<typename Primitive, typename BVH, typename Allocator>
+    __forceinline static typename BVH::NodeRef createLeaf (Geometry::GType gtype, BVH* bvh, const PrimRef* prims, const range<size_t>& set, const Allocator& alloc)
+    {
+      const size_t items = Primitive::blocks(set.size());
+      assert(items < 256);
+      UnifiedLeaf* leaf = (UnifiedLeaf*) alloc.malloc1(headerBytes+items*sizeof(Primitive),BVH::byteAlignment);
+      leaf->ty = gtype;
+      leaf->N = (unsigned char) items;
+
+      Primitive* accel = (Primitive*) ((char*)leaf + headerBytes);
+      size_t start = set.begin();
+      for (size_t i=0; i<items; i++)
+        accel[i].fill(prims,start,min(start+Primitive::max_size(),set.end()),bvh->scene);
+
+      return bvh->encodeLeaf((char*)leaf,1);
+    }
+
+  public:
+    unsigned char ty;   //!< geometry type of the stored primitives
+    unsigned char N;    //!< number of stored primitive blocks
+  };
+}
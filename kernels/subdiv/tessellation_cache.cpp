@@ -23,17 +23,20 @@ namespace embree
   __thread ThreadWorkState* SharedLazyTessellationCache::init_t_state = nullptr;
   ThreadWorkState* SharedLazyTessellationCache::current_t_state = nullptr;
 
-  void resizeTessellationCache(size_t new_size)
+  void resizeTessellationCache(size_t new_size, size_t new_partitions)
   {    
     if (new_size >= SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE)
       new_size = SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE;
-    if (SharedLazyTessellationCache::sharedLazyTessellationCache.getSize() != new_size) 
-      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size);    
+    if (new_partitions == 0)
+      new_partitions = getNumberOfNumaNodes();
+    new_partitions = clamp(new_partitions,size_t(1),SharedLazyTessellationCache::MAX_CACHE_PARTITIONS);
+    if (SharedLazyTessellationCache::sharedLazyTessellationCache.getSize() != new_size ||
+        SharedLazyTessellationCache::sharedLazyTessellationCache.getNumPartitions() != new_partitions) 
+      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size,new_partitions);    
   }
 
   void resetTessellationCache()
   {
-    //SharedLazyTessellationCache::sharedLazyTessellationCache.addCurrentIndex(SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
     SharedLazyTessellationCache::sharedLazyTessellationCache.reset();
   }
   
@@ -43,18 +46,16 @@ namespace embree
     data = nullptr;
     hugepages = false;
     maxBlocks              = size/BLOCK_SIZE;
-    localTime              = NUM_CACHE_SEGMENTS;
-    next_block             = 0;
+    numNodes               = getNumberOfNumaNodes();
+    numPartitions          = 1;
+    partitionBlocks        = 0;
+    partitionBytes         = 1;
+    segmentBlocks          = 0;
+    partitions             = new Partition[MAX_CACHE_PARTITIONS];
+    epoch                  = 0;
     numRenderThreads       = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
+    numFlushes             = 0;
     threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
-
-    //reset_state.reset();
-    //linkedlist_mtx.reset();
   }
 
   SharedLazyTessellationCache::~SharedLazyTessellationCache() 
@@ -67,6 +68,7 @@ namespace embree
     }
 
     delete[] threadWorkState;
+    delete[] partitions;
   }
 
   void SharedLazyTessellationCache::getNextRenderThreadWorkState() 
@@ -74,6 +76,8 @@ namespace embree
     const size_t id = numRenderThreads.fetch_add(1); 
     if (id >= NUM_PREALLOC_THREAD_WORK_STATES) init_t_state = new ThreadWorkState(true);
     else                                       init_t_state = &threadWorkState[id];
+    init_t_state->id   = id;
+    init_t_state->node = getCurrentNumaNode();
     
     /* critical section for updating link list with new thread state */
     linkedlist_mtx.lock();
@@ -94,59 +98,70 @@ namespace embree
      }
    }
 
-  void SharedLazyTessellationCache::allocNextSegment() 
+  void SharedLazyTessellationCache::waitForEpoch(const size_t e)
   {
-    if (reset_state.try_lock())
+    /* wait for all threads that are inside the cache since an older epoch */
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
     {
-      if (next_block >= switch_block_threshold)
+      while (t->counter.load() != 0 && t->epoch.load() < e)
       {
-        /* lock the linked list of thread states */
-        
-        linkedlist_mtx.lock();
-        
-        /* block all threads */
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-            waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
-        
-        /* switch to the next segment */
-        addCurrentIndex();
-        CACHE_STATS(PRINT("RESET TESS CACHE"));
-        
+        _mm_pause();
+        _mm_pause();
+        _mm_pause();
+        _mm_pause();
+      }
+    }
+    linkedlist_mtx.unlock();
+  }
+
+  void SharedLazyTessellationCache::setSegment(Partition& partition)
+  {
 #if FORCE_SIMPLE_FLUSH == 1
-        next_block = 0;
-        switch_block_threshold = maxBlocks;
+    partition.next_block = partition.begin_block;
+    partition.switch_block_threshold = partition.begin_block + partitionBlocks;
 #else
-        const size_t region = localTime % NUM_CACHE_SEGMENTS;
-        next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-        switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-        assert( switch_block_threshold <= maxBlocks );
+    const size_t region = partition.localTime % NUM_CACHE_SEGMENTS;
+    partition.next_block = partition.begin_block + region * segmentBlocks;
+    partition.switch_block_threshold = partition.next_block + segmentBlocks;
+    assert( partition.switch_block_threshold <= maxBlocks );
 #endif
-        
-        CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
-        
-        /* release all blocked threads */
-        
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-        
-        /* unlock the linked list of thread states */
-        
-        linkedlist_mtx.unlock();
-	
-        
+  }
+
+  void SharedLazyTessellationCache::allocNextSegment(Partition& partition) 
+  {
+    if (partition.reset_state.try_lock())
+    {
+      if (partition.next_block >= partition.switch_block_threshold)
+      {
+        /* let all further allocations fail until the next segment is ready */
+        partition.switch_block_threshold = 0;
+
+        /* switch to the next segment, which invalidates the oldest segment of this partition */
+        partition.localTime++;
+
+        /* threads that enter the cache from now on see the new time
+         * and can no longer obtain pointers into the oldest segment,
+         * thus we only wait for the threads that entered earlier
+         * instead of blocking all render threads */
+        waitForEpoch(++epoch);
+
+        setSegment(partition);
+        partition.usedSegments = min(partition.usedSegments+1,NUM_CACHE_SEGMENTS-1);
+        numFlushes++;
       }
-      reset_state.unlock();
+      partition.reset_state.unlock();
     }
     else
-      reset_state.wait_until_unlocked();	   
+      partition.reset_state.wait_until_unlocked();	   
   }
-  
-  
-  void SharedLazyTessellationCache::reset()
+
+  void SharedLazyTessellationCache::lockAllThreads()
   {
     /* lock the reset_state */
     reset_state.lock();
+    for (size_t i=0; i<MAX_CACHE_PARTITIONS; i++)
+      partitions[i].reset_state.lock();
 
     /* lock the linked list of thread states */
     linkedlist_mtx.lock();
@@ -155,18 +170,10 @@ namespace embree
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
       if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
         waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+  }
 
-    /* reset to the first segment */
-    next_block = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
-
-    /* reset local time */
-    localTime = NUM_CACHE_SEGMENTS;
-
+  void SharedLazyTessellationCache::unlockAllThreads()
+  {
     /* release all blocked threads */
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
       unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
@@ -175,21 +182,28 @@ namespace embree
     linkedlist_mtx.unlock();	    
 
     /* unlock the reset_state */
+    for (size_t i=0; i<MAX_CACHE_PARTITIONS; i++)
+      partitions[i].reset_state.unlock();
     reset_state.unlock();
   }
-
-  void SharedLazyTessellationCache::realloc(const size_t new_size)
+  
+  void SharedLazyTessellationCache::reset()
   {
-    /* lock the reset_state */
-    reset_state.lock();
+    lockAllThreads();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
+    /* reset to the first segment and reset local time */
+    for (size_t i=0; i<numPartitions; i++) {
+      partitions[i].localTime = NUM_CACHE_SEGMENTS;
+      partitions[i].usedSegments = 0;
+      setSegment(partitions[i]);
+    }
 
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+    unlockAllThreads();
+  }
+
+  void SharedLazyTessellationCache::realloc(const size_t new_size, const size_t new_partitions)
+  {
+    lockAllThreads();
 
     /* reallocate data */
     if (data) os_free(data,size,hugepages);
@@ -198,29 +212,28 @@ namespace embree
     if (size) data = (float*)os_malloc(size,hugepages);
     maxBlocks = size/BLOCK_SIZE;    
 
-    /* invalidate entire cache */
-    localTime += NUM_CACHE_SEGMENTS; 
+    /* split data into partitions of equally sized segments */
+    numPartitions   = new_partitions;
+    partitionBlocks = (maxBlocks/numPartitions/NUM_CACHE_SEGMENTS)*NUM_CACHE_SEGMENTS;
+    partitionBytes  = max(partitionBlocks*BLOCK_SIZE,size_t(1));
+    segmentBlocks   = partitionBlocks/NUM_CACHE_SEGMENTS;
 
-    /* reset to the first segment */
-#if FORCE_SIMPLE_FLUSH == 1
-    next_block = 0;
-    switch_block_threshold = maxBlocks;
-#else
-    const size_t region = localTime % NUM_CACHE_SEGMENTS;
-    next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-    switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-    assert( switch_block_threshold <= maxBlocks );
-#endif
+    /* invalidate entire cache, the partition of existing tags may change */
+    size_t time = 0;
+    for (size_t i=0; i<MAX_CACHE_PARTITIONS; i++)
+      time = max(time,partitions[i].localTime.load());
+    time += NUM_CACHE_SEGMENTS;
 
-    /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    /* reset to the first segment */
+    for (size_t i=0; i<MAX_CACHE_PARTITIONS; i++)
+    {
+      partitions[i].localTime = time;
+      partitions[i].begin_block = min(i,numPartitions-1)*partitionBlocks;
+      partitions[i].usedSegments = 0;
+      setSegment(partitions[i]);
+    }
 
-    /* unlock the reset_state */
-    reset_state.unlock();
+    unlockAllThreads();
   }
 
 
@@ -228,30 +241,47 @@ namespace embree
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  std::atomic<size_t> SharedTessellationCacheStats::cache_accesses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_hits(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_misses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_flushes(0);  
-  SpinLock   SharedTessellationCacheStats::mtx;  
-  size_t SharedTessellationCacheStats::cache_num_patches(0);
+  size_t SharedLazyTessellationCache::getNumHits()
+  {
+    size_t hits = 0;
+    Lock<SpinLock> lock(linkedlist_mtx);
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      hits += t->hits;
+    return hits;
+  }
+
+  size_t SharedLazyTessellationCache::getNumMisses()
+  {
+    size_t misses = 0;
+    Lock<SpinLock> lock(linkedlist_mtx);
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      misses += t->misses;
+    return misses;
+  }
 
-  void SharedTessellationCacheStats::printStats()
+  size_t SharedLazyTessellationCache::getNumUsedBytes()
   {
-    PRINT(cache_accesses);
-    PRINT(cache_misses);
-    PRINT(cache_hits);
-    PRINT(cache_flushes);
-    PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
-    PRINT(cache_num_patches);
+    /* the filled segments plus the used part of the current segment of each partition */
+    size_t blocks = 0;
+    for (size_t i=0; i<numPartitions; i++)
+    {
+      const size_t threshold = partitions[i].switch_block_threshold;
+      if (threshold == 0) continue;
+      const size_t begin = threshold-segmentBlocks;
+      const size_t end = min(partitions[i].next_block.load(),threshold);
+      blocks += partitions[i].usedSegments*segmentBlocks + (end > begin ? end-begin : 0);
+    }
+    return blocks*BLOCK_SIZE;
   }
 
-  void SharedTessellationCacheStats::clearStats()
+  void SharedLazyTessellationCache::clearStats()
   {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
-    SharedTessellationCacheStats::cache_flushes   = 0;
+    Lock<SpinLock> lock(linkedlist_mtx);
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next) {
+      t->hits = 0;
+      t->misses = 0;
+    }
+    numFlushes = 0;
   }
 
   struct cache_regression_test : public RegressionTest
@@ -333,7 +363,11 @@ namespace embree
 
 extern "C" void printTessCacheStats()
 {
+  embree::SharedLazyTessellationCache& cache = embree::SharedLazyTessellationCache::sharedLazyTessellationCache;
   PRINT("SHARED TESSELLATION CACHE");
-  embree::SharedTessellationCacheStats::printStats();
-  embree::SharedTessellationCacheStats::clearStats();
+  PRINT(cache.getNumHits());
+  PRINT(cache.getNumMisses());
+  PRINT(cache.getNumFlushes());
+  PRINT(cache.getNumUsedBytes());
+  cache.clearStats();
 }
@@ -23,31 +23,9 @@
 
 #define THREAD_BLOCK_ATOMIC_ADD 4
 
-#if defined(DEBUG)
-#define CACHE_STATS(x) 
-#else
-#define CACHE_STATS(x) 
-#endif
-
 namespace embree
 {
-  class SharedTessellationCacheStats
-  {
-  public:
-    /* stats */
-    static std::atomic<size_t> cache_accesses;
-    static std::atomic<size_t> cache_hits;
-    static std::atomic<size_t> cache_misses;
-    static std::atomic<size_t> cache_flushes;                
-    static size_t        cache_num_patches;
-    __aligned(64) static SpinLock mtx;
-    
-    /* print stats for debugging */                 
-    static void printStats();
-    static void clearStats();
-  };
-  
-  void resizeTessellationCache(size_t new_size);
+  void resizeTessellationCache(size_t new_size, size_t new_partitions = 0);
   void resetTessellationCache();
   
  ////////////////////////////////////////////////////////////////////////////////
@@ -59,11 +37,16 @@ namespace embree
    ALIGNED_STRUCT_(64);
 
    std::atomic<size_t> counter;
+   std::atomic<size_t> epoch;     //!< global epoch observed when the thread entered the cache
+   std::atomic<size_t> hits;      //!< number of cache lookups of this thread that found a patch
+   std::atomic<size_t> misses;    //!< number of patches this thread had to build
    ThreadWorkState* next;
+   size_t id;                     //!< index of the thread in registration order
+   unsigned int node;             //!< NUMA node the thread runs on
    bool allocated;
 
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), epoch(0), hits(0), misses(0), next(nullptr), id(0), node(0), allocated(allocated) 
    {
      assert( ((size_t)this % 64) == 0 ); 
    }   
@@ -74,6 +57,7 @@ namespace embree
  public:
    
    static const size_t NUM_CACHE_SEGMENTS              = 8;
+   static const size_t MAX_CACHE_PARTITIONS            = 64;
    static const size_t NUM_PREALLOC_THREAD_WORK_STATES = 512;
    static const size_t COMMIT_INDEX_SHIFT              = 32+8;
 #if defined(__X86_64__)
@@ -138,20 +122,47 @@ namespace embree
      SpinLock mutex;
    };
 
+   /*! The cache memory is split into one partition per NUMA node
+    *  (or a user specified number of partitions). Each partition is a
+    *  ring of NUM_CACHE_SEGMENTS segments with its own time, so
+    *  threads of different sockets allocate and evict patches
+    *  independently. As threads only touch the memory of their own
+    *  partition when building patches, the first touch policy of the
+    *  OS places each partition on the node that uses it. */
+   struct __aligned(64) Partition
+   {
+     ALIGNED_STRUCT_(64);
+
+     Partition () 
+       : localTime(NUM_CACHE_SEGMENTS), next_block(0), switch_block_threshold(0), begin_block(0), usedSegments(0) {}
+
+     __aligned(64) std::atomic<size_t> localTime;
+     __aligned(64) std::atomic<size_t> next_block;
+     __aligned(64) std::atomic<size_t> switch_block_threshold;
+     __aligned(64) SpinLock reset_state;
+     size_t begin_block;
+     std::atomic<size_t> usedSegments;  //!< number of completely filled segments that still hold valid patches
+   };
+
  private:
 
    float *data;
    bool hugepages;
    size_t size;
    size_t maxBlocks;
+   size_t numNodes;
+   size_t numPartitions;
+   size_t partitionBlocks;
+   size_t partitionBytes;
+   size_t segmentBlocks;
+   Partition* partitions;
    ThreadWorkState *threadWorkState;
       
-   __aligned(64) std::atomic<size_t> localTime;
-   __aligned(64) std::atomic<size_t> next_block;
+   __aligned(64) std::atomic<size_t> epoch;
    __aligned(64) SpinLock   reset_state;
    __aligned(64) SpinLock   linkedlist_mtx;
-   __aligned(64) std::atomic<size_t> switch_block_threshold;
    __aligned(64) std::atomic<size_t> numRenderThreads;
+   __aligned(64) std::atomic<size_t> numFlushes;
 
 
  public:
@@ -163,18 +174,34 @@ namespace embree
    void getNextRenderThreadWorkState();
 
    __forceinline size_t maxAllocSize() const {
-     return switch_block_threshold;
+     return segmentBlocks;
    }
 
-   __forceinline size_t getCurrentIndex() { return localTime.load(); }
-   __forceinline void   addCurrentIndex(const size_t i=1) { localTime.fetch_add(i); }
+   /* partition the calling thread allocates from, threads of a node
+    * are distributed over the partitions of that node */
+   __forceinline Partition& threadPartition() {
+     ThreadWorkState* t_state = threadState();
+     return partitions[(t_state->node + numNodes*t_state->id) % numPartitions];
+   }
+
+   /* partition that contains the specified byte offset into the cache */
+   __forceinline Partition& offsetPartition(const size_t offset) {
+     return partitions[min(offset/partitionBytes,numPartitions-1)];
+   }
 
    __forceinline size_t getTime(const size_t globalTime) {
-     return localTime.load()+NUM_CACHE_SEGMENTS*globalTime;
+     return threadPartition().localTime.load()+NUM_CACHE_SEGMENTS*globalTime;
    }
 
+   /* entering the cache records the current epoch, such that segment
+    * switches only have to wait for threads that entered before */
+   __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) 
+   { 
+     const size_t users = t_state->counter.fetch_add(plus);
+     if (users == 0) t_state->epoch.store(epoch.load());
+     return users;
+   }
 
-   __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) { return t_state->counter.fetch_add(plus);  }
    __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1) { assert(isLocked(t_state)); return t_state->counter.fetch_add(plus); }
 
    __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter.load() != 0; }
@@ -209,20 +236,17 @@ namespace embree
    static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
-       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)sharedLazyTessellationCache.getDataPtr();
+       const size_t subdiv_patch_offset = subdiv_patch_root_ref & REF_TAG_MASK;
+       const size_t subdiv_patch_root = subdiv_patch_offset + (size_t)sharedLazyTessellationCache.getDataPtr();
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
+       Partition& partition = sharedLazyTessellationCache.offsetPartition(subdiv_patch_offset);
        
-       if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
-       {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
+       if (likely( validCacheIndex(partition,subdiv_patch_cache_index,globalTime) ))
          return (void*) subdiv_patch_root;
-       }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
@@ -235,12 +259,16 @@ namespace embree
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
        void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       if (patch) {
+         t_state->hits++;
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
+           t_state->misses++;
            auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
@@ -259,12 +287,13 @@ namespace embree
      }
    }
    
-   __forceinline bool validCacheIndex(const size_t i, const size_t globalTime)
+   static __forceinline bool validCacheIndex(const Partition& partition, const size_t i, const size_t globalTime)
    {
+     const size_t time = partition.localTime.load()+NUM_CACHE_SEGMENTS*globalTime;
 #if FORCE_SIMPLE_FLUSH == 1
-     return i == getTime(globalTime);
+     return i == time;
 #else
-     return i+(NUM_CACHE_SEGMENTS-1) >= getTime(globalTime);
+     return i+(NUM_CACHE_SEGMENTS-1) >= time;
 #endif
    }
 
@@ -279,20 +308,25 @@ namespace embree
       const int64_t subdiv_patch_root_ref = tag.get(); 
       if (subdiv_patch_root_ref == 0) return false;
       const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
-      return sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime);
+      Partition& partition = sharedLazyTessellationCache.offsetPartition(subdiv_patch_root_ref & REF_TAG_MASK);
+      return validCacheIndex(partition,subdiv_patch_cache_index,globalTime);
     }
 
    void waitForUsersLessEqual(ThreadWorkState *const t_state,
 			      const unsigned int users);
+
+   void waitForEpoch(const size_t e);
     
-   __forceinline size_t alloc(const size_t blocks)
+   __forceinline size_t alloc(Partition& partition, const size_t blocks)
    {
-     if (unlikely(blocks >= switch_block_threshold))
+     if (unlikely(blocks >= segmentBlocks))
        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"allocation exceeds size of tessellation cache segment");
 
-     assert(blocks < switch_block_threshold);
-     size_t index = next_block.fetch_add(blocks);
-     if (unlikely(index + blocks >= switch_block_threshold)) return (size_t)-1;
+     /* the threshold has to be read before the allocation, as a
+      * segment switch may run concurrently with this allocation */
+     const size_t threshold = partition.switch_block_threshold.load();
+     size_t index = partition.next_block.fetch_add(blocks);
+     if (unlikely(index + blocks >= threshold)) return (size_t)-1;
      return index;
    }
 
@@ -300,13 +334,14 @@ namespace embree
    {
      size_t block_index = -1;
      ThreadWorkState *const t_state = threadState();
+     Partition& partition = sharedLazyTessellationCache.threadPartition();
      while (true)
      {
-       block_index = sharedLazyTessellationCache.alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
+       block_index = sharedLazyTessellationCache.alloc(partition,(bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
        if (block_index == (size_t)-1)
        {
          sharedLazyTessellationCache.unlockThread(t_state);		  
-         sharedLazyTessellationCache.allocNextSegment();
+         sharedLazyTessellationCache.allocNextSegment(partition);
          sharedLazyTessellationCache.lockThread(t_state);
          continue; 
        }
@@ -323,13 +358,23 @@ namespace embree
      return (void*)&data[block_index*16];
    }
 
-   __forceinline void*  getDataPtr()      { return data; }
-   __forceinline size_t getNumUsedBytes() { return next_block * BLOCK_SIZE; }
-   __forceinline size_t getMaxBlocks()    { return maxBlocks; }
-   __forceinline size_t getSize()         { return size; }
-
-   void allocNextSegment();
-   void realloc(const size_t newSize);
+   __forceinline void*  getDataPtr()       { return data; }
+   __forceinline size_t getMaxBlocks()     { return maxBlocks; }
+   __forceinline size_t getSize()          { return size; }
+   __forceinline size_t getNumPartitions() { return numPartitions; }
+   __forceinline size_t getNumFlushes()    { return numFlushes; }
+
+   /* statistics over all threads that used the cache */
+   size_t getNumHits();
+   size_t getNumMisses();
+   size_t getNumUsedBytes();
+   void clearStats();
+
+   void allocNextSegment(Partition& partition);
+   void realloc(const size_t newSize, const size_t newPartitions);
+   void setSegment(Partition& partition);
+   void lockAllThreads();
+   void unlockAllThreads();
 
    void reset();
 
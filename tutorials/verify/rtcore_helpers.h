@@ -510,6 +510,7 @@ namespace embree
     VARIANT_OCCLUDED = 2,
     VARIANT_COHERENT = 0,
     VARIANT_INCOHERENT = 4,
+    VARIANT_SORTED = 8,     // incoherent ray streams sorted into coherent groups
     VARIANT_INTERSECT_OCCLUDED_MASK = 3,
     VARIANT_COHERENT_INCOHERENT_MASK = 4,
     
@@ -520,6 +521,9 @@ namespace embree
     VARIANT_INTERSECT_OCCLUDED = 3,
     VARIANT_INTERSECT_OCCLUDED_COHERENT = 3, // intersect but verify if occluded also finds hit or not
     VARIANT_INTERSECT_OCCLUDED_INCOHERENT = 7, // intersect but verify if occluded also finds hit or not
+    VARIANT_INTERSECT_SORTED = 13,
+    VARIANT_OCCLUDED_SORTED = 14,
+    VARIANT_INTERSECT_OCCLUDED_SORTED = 15,
   };
 
   inline std::string to_string(IntersectVariant ivariant)
@@ -531,6 +535,9 @@ namespace embree
     case VARIANT_OCCLUDED_INCOHERENT : return "OccludedIncoherent";
     case VARIANT_INTERSECT_OCCLUDED_COHERENT: return "IntersectOccludedCoherent";
     case VARIANT_INTERSECT_OCCLUDED_INCOHERENT : return "IntersectOccludedIncoherent";
+    case VARIANT_INTERSECT_SORTED: return "IntersectSorted";
+    case VARIANT_OCCLUDED_SORTED : return "OccludedSorted";
+    case VARIANT_INTERSECT_OCCLUDED_SORTED : return "IntersectOccludedSorted";
     default: assert(false);
     }
     return "";
@@ -579,6 +586,8 @@ namespace embree
     else ret += "Static";
     if (scene_flags & RTC_SCENE_FLAG_COMPACT) ret += "Compact";
     if (scene_flags & RTC_SCENE_FLAG_ROBUST ) ret += "Robust";
+    if (scene_flags & RTC_SCENE_FLAG_UNIFIED_ACCEL) ret += "Unified";
+    if (scene_flags & RTC_SCENE_FLAG_NUMA_REPLICATE) ret += "Replicate";
     if (!(scene_flags & RTC_SCENE_FLAG_COMPACT) && !(scene_flags & RTC_SCENE_FLAG_ROBUST)) ret += "Fast"; 
     return ret;
   }
@@ -715,6 +724,7 @@ namespace embree
     RTCIntersectContext context;
     rtcInitIntersectContext(&context);
     context.flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT :  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+    if (ivariant & VARIANT_SORTED) context.flags = RTC_INTERSECT_CONTEXT_FLAG_SORT;
 
     switch (mode) 
     {
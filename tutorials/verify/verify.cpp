@@ -22,6 +22,8 @@
 #include "../../common/algorithms/parallel_for.h"
 #include <regex>
 #include <stack>
+#include <set>
+#include <thread>
 
 #define random  use_random_function_of_test // do use random_int() and random_float() from Test class
 #define drand48 use_random_function_of_test // do use random_int() and random_float() from Test class
@@ -686,17 +688,19 @@ namespace embree
 
   struct EmbreeInternalTest : public VerifyApplication::Test
   {
-    EmbreeInternalTest (std::string name, size_t testID)
-      : VerifyApplication::Test(name,0,VerifyApplication::TEST_SHOULD_PASS), testID(testID) {}
+    EmbreeInternalTest (std::string name, size_t testID, std::string cfg = "")
+      : VerifyApplication::Test(name,0,VerifyApplication::TEST_SHOULD_PASS), testID(testID), cfg(cfg) {}
   
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
-      RTCDeviceRef device = rtcNewDevice(state->rtcore.c_str());
+      std::string cfg = state->rtcore + this->cfg;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       AssertNoError(device);
       return (VerifyApplication::TestReturnValue)rtcGetDeviceProperty(device,(RTCDeviceProperty)(3000000+testID));
     }
 
     size_t testID;
+    std::string cfg;
   };
 
   struct os_shrink_test : public VerifyApplication::Test
@@ -898,6 +902,103 @@ namespace embree
     }
   };
 
+  struct RayStatisticsTest : public VerifyApplication::Test
+  {
+    RayStatisticsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,50));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_RAY_STATISTICS_ENABLED,1);
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_INTERSECT_RAYS,0);
+      AssertNoError(device);
+      if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_RAY_STATISTICS_ENABLED)) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_INTERSECT_RAYS) != 0) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_OCCLUDED_RAYS) != 0) return VerifyApplication::FAILED;
+
+      /* trace rays only while the statistics are enabled */
+      const ssize_t N = 64;
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      for (size_t j=0; j<2; j++)
+      {
+        for (ssize_t i=0; i<N; i++)
+        {
+          const Vec3fa org(0.5f*random_float()-0.25f,0.5f*random_float()-0.25f,-4.0f);
+          RTCRayHit ray = makeRay(org,Vec3fa(0,0,1));
+          rtcIntersect1(scene,&context,&ray);
+          rtcOccluded1(scene,&context,&ray.ray);
+          if (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        }
+        rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_RAY_STATISTICS_ENABLED,0);
+      }
+      AssertNoError(device);
+
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_INTERSECT_RAYS) != N) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_INTERSECT_NODES) <= 0) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_INTERSECT_LEAVES) <= 0) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_INTERSECT_PRIMITIVES) <= 0) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_INTERSECT_INSTANCES) != 0) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_OCCLUDED_RAYS) != N) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_OCCLUDED_NODES) <= 0) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_OCCLUDED_PRIMITIVES) <= 0) return VerifyApplication::FAILED;
+
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_OCCLUDED_RAYS,0);
+      AssertNoError(device);
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_INTERSECT_RAYS) != 0) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_OCCLUDED_NODES) != 0) return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct NumaPolicyTest : public VerifyApplication::Test
+  {
+    std::string policy;
+    
+    NumaPolicyTest (std::string name, int isa, std::string policy)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), policy(policy) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",alloc_numa_policy="+policy;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* large scene such that the allocator uses blocks that get placed */
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,500));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa org(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,-4.0f);
+        RTCRayHit ray = makeRay(org,Vec3fa(0,0,1));
+        rtcIntersect1(scene,&context,&ray);
+        const bool hit = org.x*org.x + org.y*org.y < 0.98f;
+        const bool miss = org.x*org.x + org.y*org.y > 1.02f;
+        if (hit  && ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        if (miss && ray.hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct BufferStrideTest : public VerifyApplication::Test
   {
     GeometryType gtype;
@@ -1158,6 +1259,300 @@ namespace embree
     }
   };
 
+  struct BVHCacheTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    BVHCacheTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+#if defined(__WIN32__)
+      const char* tmpdir = getenv("TEMP");
+#else
+      const char* tmpdir = getenv("TMPDIR");
+      if (tmpdir == nullptr) tmpdir = "/tmp";
+#endif
+      if (tmpdir == nullptr) return VerifyApplication::SKIPPED;
+      
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      std::string cfg_cache = cfg + ",bvh_cache_dir=\""+tmpdir+"\"";
+      RTCDeviceRef device_cache = rtcNewDevice(cfg_cache.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device_cache));
+
+      /* the first scene is built without cache, the second one stores
+       * into the cache and the third scene loads from the cache */
+      const Vec3fa center = zero;
+      const float radius = 1.0f;
+      Ref<VerifyScene> scenes[3];
+      for (size_t i=0; i<3; i++)
+      {
+        scenes[i] = new VerifyScene(i == 0 ? device : device_cache,sflags);
+        scenes[i]->addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(center,radius,50));
+        scenes[i]->addGeometry(sflags.qflags,SceneGraph::createQuadSphere(center+Vec3fa(0.5f,0,0),radius,50));
+        rtcCommitScene (*scenes[i]);
+        AssertNoError(i == 0 ? device : device_cache);
+      }
+
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa org(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,-4.0f);
+        RTCRayHit ray0 = makeRay(org,Vec3fa(0,0,1));
+        rtcIntersect1(*scenes[0],&context,&ray0);
+        for (size_t j=1; j<3; j++)
+        {
+          RTCRayHit ray1 = makeRay(org,Vec3fa(0,0,1));
+          rtcIntersect1(*scenes[j],&context,&ray1);
+          if (ray0.hit.geomID != ray1.hit.geomID) return VerifyApplication::FAILED;
+          if (ray0.hit.primID != ray1.hit.primID) return VerifyApplication::FAILED;
+          if (ray0.ray.tfar   != ray1.ray.tfar  ) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device_cache);
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  /* closest point on triangle (v0,v1,v2) to point p */
+  static Vec3fa closestPointTriangle(const Vec3fa& p, const Vec3fa& a, const Vec3fa& b, const Vec3fa& c)
+  {
+    const Vec3fa ab = b-a, ac = c-a, ap = p-a;
+    const float d1 = dot(ab,ap), d2 = dot(ac,ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+    
+    const Vec3fa bp = p-b;
+    const float d3 = dot(ab,bp), d4 = dot(ac,bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+    
+    const Vec3fa cp = p-c;
+    const float d5 = dot(ab,cp), d6 = dot(ac,cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+    
+    const float vc = d1*d4-d3*d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + d1/(d1-d3)*ab;
+    
+    const float vb = d5*d2-d1*d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + d2/(d2-d6)*ac;
+    
+    const float va = d3*d6-d5*d4;
+    if (va <= 0.0f && (d4-d3) >= 0.0f && (d5-d6) >= 0.0f) return b + (d4-d3)/((d4-d3)+(d5-d6))*(c-b);
+    
+    const float denom = 1.0f/(va+vb+vc);
+    return a + vb*denom*ab + vc*denom*ac;
+  }
+
+  struct PointQueryTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool instancing;
+
+    struct UserData
+    {
+      Ref<SceneGraph::TriangleMeshNode> mesh;
+      unsigned int primID;
+      float dist;
+    };
+
+    PointQueryTest (std::string name, int isa, SceneFlags sflags, bool instancing)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), instancing(instancing) {}
+
+    static bool pointQueryFunc(RTCPointQueryFunctionArguments* args)
+    {
+      UserData* data = (UserData*) args->userPtr;
+      const SceneGraph::TriangleMeshNode::Triangle& tri = data->mesh->triangles[args->primID];
+      const Vec3fa q(args->query->x,args->query->y,args->query->z);
+      const Vec3fa v0 = data->mesh->positions[0][tri.v0];
+      const Vec3fa v1 = data->mesh->positions[0][tri.v1];
+      const Vec3fa v2 = data->mesh->positions[0][tri.v2];
+      const float d = length(q-closestPointTriangle(q,v0,v1,v2));
+      if (d >= args->query->radius) return false;
+      args->query->radius = d;
+      data->primID = args->primID;
+      data->dist = args->context->instStackSize ? d/args->similarityScale : d;
+      return true;
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      UserData data;
+      data.mesh = SceneGraph::createTriangleSphere(zero,1.0f,50).dynamicCast<SceneGraph::TriangleMeshNode>();
+
+      /* the sphere is either placed directly into the scene or instanced with a similarity transformation */
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(1.0f,2.0f,3.0f))*AffineSpace3fa::rotate(Vec3fa(1,1,0),0.3f)*AffineSpace3fa::scale(Vec3fa(2.0f));
+      Ref<VerifyScene> mesh_scene = new VerifyScene(device,sflags);
+      mesh_scene->addGeometry(sflags.qflags,data.mesh.dynamicCast<SceneGraph::Node>());
+      rtcCommitScene(*mesh_scene);
+      AssertNoError(device);
+
+      Ref<VerifyScene> scene = mesh_scene;
+      if (instancing)
+      {
+        scene = new VerifyScene(device,sflags);
+        RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(geom,*mesh_scene);
+        rtcSetGeometryTransform(geom,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,&xfm);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(*scene,geom);
+        rtcReleaseGeometry(geom);
+        rtcCommitScene(*scene);
+        AssertNoError(device);
+      }
+
+      for (size_t i=0; i<128; i++)
+      {
+        const Vec3fa p = 4.0f*Vec3fa(random_float(),random_float(),random_float())-Vec3fa(2.0f);
+        const Vec3fa q = instancing ? xfmPoint(xfm,p) : p;
+
+        RTCPointQuery query;
+        query.x = q.x; query.y = q.y; query.z = q.z;
+        query.time = 0.0f;
+        query.radius = inf;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        data.primID = RTC_INVALID_GEOMETRY_ID;
+        data.dist = inf;
+        rtcPointQuery(*scene,&query,&context,pointQueryFunc,&data);
+        AssertNoError(device);
+        if (data.primID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        if (context.instStackSize != 0) return VerifyApplication::FAILED;
+
+        /* compare against brute force closest point calculation */
+        float dist = inf;
+        for (const auto& tri : data.mesh->triangles) {
+          const Vec3fa v0 = data.mesh->positions[0][tri.v0];
+          const Vec3fa v1 = data.mesh->positions[0][tri.v1];
+          const Vec3fa v2 = data.mesh->positions[0][tri.v2];
+          dist = min(dist,length(p-closestPointTriangle(p,v0,v1,v2)));
+        }
+        const float world_dist = instancing ? 2.0f*dist : dist;
+        if (abs(data.dist-world_dist) > 1E-4f*max(1.0f,world_dist)) return VerifyApplication::FAILED;
+        if (abs(query.radius-world_dist) > 1E-4f*max(1.0f,world_dist)) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CollideTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool self;
+
+    struct Boxes
+    {
+      unsigned int geomID;
+      std::vector<BBox3fa> bounds;
+    };
+
+    struct Collisions
+    {
+      MutexSys mutex;
+      std::vector<std::tuple<unsigned,unsigned,unsigned,unsigned>> pairs;
+    };
+
+    CollideTest (std::string name, int isa, SceneFlags sflags, bool self)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), self(self) {}
+
+    static void boundsFunc(const struct RTCBoundsFunctionArguments* args)
+    {
+      const Boxes* boxes = (const Boxes*) args->geometryUserPtr;
+      const BBox3fa& b = boxes->bounds[args->primID];
+      args->bounds_o->lower_x = b.lower.x; args->bounds_o->lower_y = b.lower.y; args->bounds_o->lower_z = b.lower.z;
+      args->bounds_o->upper_x = b.upper.x; args->bounds_o->upper_y = b.upper.y; args->bounds_o->upper_z = b.upper.z;
+    }
+
+    static void collideFunc(void* userPtr, RTCCollision* collisions, unsigned int num_collisions)
+    {
+      Collisions* c = (Collisions*) userPtr;
+      Lock<MutexSys> lock(c->mutex);
+      for (unsigned int i=0; i<num_collisions; i++)
+        c->pairs.push_back(std::make_tuple(collisions[i].geomID0,collisions[i].primID0,collisions[i].geomID1,collisions[i].primID1));
+    }
+
+    void addBoxes(RTCDevice device, RTCScene scene, Boxes& boxes, size_t N)
+    {
+      for (size_t i=0; i<N; i++) {
+        const Vec3fa p = 10.0f*Vec3fa(random_float(),random_float(),random_float());
+        const Vec3fa d = 0.5f*Vec3fa(random_float(),random_float(),random_float());
+        boxes.bounds.push_back(BBox3fa(p,p+d));
+      }
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_USER);
+      rtcSetGeometryUserPrimitiveCount(geom,(unsigned int)N);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+      rtcSetGeometryUserData(geom,&boxes);
+      rtcSetGeometryBoundsFunction(geom,boundsFunc,nullptr);
+      rtcCommitGeometry(geom);
+      boxes.geomID = rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      std::vector<Boxes> boxes0(2), boxes1(1);
+      VerifyScene scene0(device,sflags);
+      addBoxes(device,scene0,boxes0[0],1000);
+      addBoxes(device,scene0,boxes0[1],500);
+      rtcCommitScene(scene0);
+      AssertNoError(device);
+
+      VerifyScene scene1(device,sflags);
+      addBoxes(device,scene1,boxes1[0],800);
+      rtcCommitScene(scene1);
+      AssertNoError(device);
+
+      if (self) boxes1 = boxes0;
+      Collisions collisions;
+      rtcCollide(scene0,self ? (RTCScene)scene0 : (RTCScene)scene1,collideFunc,&collisions);
+      AssertNoError(device);
+
+      /* compare against brute force overlap test */
+      std::vector<std::tuple<unsigned,unsigned,unsigned,unsigned>> expected;
+      for (const Boxes& b0 : boxes0)
+        for (unsigned i=0; i<b0.bounds.size(); i++)
+          for (const Boxes& b1 : boxes1)
+            for (unsigned j=0; j<b1.bounds.size(); j++)
+            {
+              if (self && std::make_pair(b0.geomID,i) >= std::make_pair(b1.geomID,j)) continue;
+              if (disjoint(b0.bounds[i],b1.bounds[j])) continue;
+              expected.push_back(std::make_tuple(b0.geomID,i,b1.geomID,j));
+            }
+
+      /* self collisions may report a pair in either order */
+      if (self) {
+        for (auto& p : collisions.pairs)
+          if (std::make_pair(std::get<0>(p),std::get<1>(p)) > std::make_pair(std::get<2>(p),std::get<3>(p)))
+            p = std::make_tuple(std::get<2>(p),std::get<3>(p),std::get<0>(p),std::get<1>(p));
+      }
+      std::sort(expected.begin(),expected.end());
+      std::sort(collisions.pairs.begin(),collisions.pairs.end());
+      if (expected.size() == 0) return VerifyApplication::FAILED;
+      if (collisions.pairs != expected) return VerifyApplication::FAILED;
+
+      /* scenes with other geometry types are not supported */
+      VerifyScene scene2(device,sflags);
+      scene2.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(zero,1.0f,10));
+      rtcCommitScene(scene2);
+      AssertNoError(device);
+      rtcCollide(scene2,scene2,collideFunc,&collisions);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct OverlappingGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -1588,52 +1983,683 @@ namespace embree
   {
     SceneFlags sflags;
 
-    EnableDisableGeometryTest (std::string name, int isa, SceneFlags sflags)
-      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
-    
+    EnableDisableGeometryTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+  
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+      unsigned geom0 = scene.addSphere      (sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(-1,0,-1),1.0f,50).first;
+      unsigned geom1 = scene.addQuadSphere  (sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(-1,0,+1),1.0f,50).first;
+      unsigned geom2 = scene.addSubdivSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(+1,0,-1),1.0f,5,4).first;
+      unsigned geom3 = scene.addHair        (sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(+1,0,+1),1.0f,1.0f,1).first;
+      RTCGeometry hgeom0 = rtcGetGeometry(scene,geom0);
+      RTCGeometry hgeom1 = rtcGetGeometry(scene,geom1);
+      RTCGeometry hgeom2 = rtcGetGeometry(scene,geom2);
+      RTCGeometry hgeom3 = rtcGetGeometry(scene,geom3);
+      AssertNoError(device);
+      
+      for (size_t i=0; i<16; i++) 
+      {
+        bool enabled0 = i & 1, enabled1 = i & 2, enabled2 = i & 4, enabled3 = i & 8;
+        if (enabled0) rtcEnableGeometry(hgeom0); else rtcDisableGeometry(hgeom0); AssertNoError(device);
+        if (enabled1) rtcEnableGeometry(hgeom1); else rtcDisableGeometry(hgeom1); AssertNoError(device);
+        if (enabled2) rtcEnableGeometry(hgeom2); else rtcDisableGeometry(hgeom2); AssertNoError(device);
+        if (enabled3) rtcEnableGeometry(hgeom3); else rtcDisableGeometry(hgeom3); AssertNoError(device);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+        {
+          RTCRayHit ray0 = makeRay(Vec3fa(-1,10,-1),Vec3fa(0,-1,0));
+          RTCRayHit ray1 = makeRay(Vec3fa(-1,10,+1),Vec3fa(0,-1,0)); 
+          RTCRayHit ray2 = makeRay(Vec3fa(+1,10,-1),Vec3fa(0,-1,0)); 
+          RTCRayHit ray3 = makeRay(Vec3fa(+1,10,+1),Vec3fa(0,-1,0)); 
+          rtcIntersect1(scene,&context,&ray0);
+          rtcIntersect1(scene,&context,&ray1);
+          rtcIntersect1(scene,&context,&ray2);
+          rtcIntersect1(scene,&context,&ray3);
+          bool ok0 = enabled0 ? ray0.hit.geomID == 0 : ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID;
+          bool ok1 = enabled1 ? ray1.hit.geomID == 1 : ray1.hit.geomID == RTC_INVALID_GEOMETRY_ID;
+          bool ok2 = enabled2 ? ray2.hit.geomID == 2 : ray2.hit.geomID == RTC_INVALID_GEOMETRY_ID;
+          bool ok3 = enabled3 ? ray3.hit.geomID == 3 : ray3.hit.geomID == RTC_INVALID_GEOMETRY_ID;
+          if (!ok0 || !ok1 || !ok2 || !ok3) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct UpdateTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    UpdateTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+    
+    static void move_mesh(RTCGeometry mesh, size_t numVertices, Vec3fa& pos) 
+    {
+      Vec3fa* vertices = (Vec3fa*) rtcGetGeometryBufferData(mesh,RTC_BUFFER_TYPE_VERTEX,0);
+      for (size_t i=0; i<numVertices; i++)
+        vertices[i] += Vec3fa(pos);
+      rtcUpdateGeometryBuffer(mesh,RTC_BUFFER_TYPE_VERTEX,0);
+      rtcCommitGeometry(mesh);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+      
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+      size_t numPhi = 10;
+      size_t numVertices = 2*numPhi*(numPhi+1);
+      Vec3fa pos0 = Vec3fa(-10,0,-10);
+      Vec3fa pos1 = Vec3fa(-10,0,+10);
+      Vec3fa pos2 = Vec3fa(+10,0,-10);
+      Vec3fa pos3 = Vec3fa(+10,0,+10);
+      unsigned geom0 = scene.addSphere      (sampler,quality,pos0,1.0f,numPhi).first;
+      unsigned geom1 = scene.addQuadSphere  (sampler,quality,pos1,1.0f,numPhi).first;
+      unsigned geom2 = scene.addSubdivSphere(sampler,quality,pos2,1.0f,numPhi,4).first;
+      unsigned geom3 = scene.addSphereHair  (sampler,quality,pos3,1.0f).first;
+      RTCGeometry hgeom0 = rtcGetGeometry(scene,geom0);
+      RTCGeometry hgeom1 = rtcGetGeometry(scene,geom1);
+      RTCGeometry hgeom2 = rtcGetGeometry(scene,geom2);
+      RTCGeometry hgeom3 = rtcGetGeometry(scene,geom3);
+      AssertNoError(device);
+      
+      for (size_t i=0; i<16; i++) 
+      {
+        bool move0 = i & 1, move1 = i & 2, move2 = i & 4, move3 = i & 8;
+        Vec3fa ds(2,0.1f,2,0.0f);
+        if (move0) { move_mesh(hgeom0,numVertices,ds); pos0 += ds; }
+        if (move1) { move_mesh(hgeom1,numVertices,ds); pos1 += ds; }
+        if (move2) { move_mesh(hgeom2,numVertices,ds); pos2 += ds; }
+        if (move3) { move_mesh(hgeom3,4,ds); pos3 += ds; }
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        RTCRayHit ray0 = makeRay(pos0+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 0
+        RTCRayHit ray1 = makeRay(pos1+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 1
+        RTCRayHit ray2 = makeRay(pos2+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 2
+        RTCRayHit ray3 = makeRay(pos3+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 3
+        RTCRayHit testRays[4] = { ray0, ray1, ray2, ray3 };
+
+        const unsigned int maxRays = 100;
+        RTCRayHit rays[maxRays];
+        for (unsigned int numRays=1; numRays<maxRays; numRays++) {
+          for (size_t i=0; i<numRays; i++) rays[i] = testRays[i%4];
+          IntersectWithMode(imode,ivariant,scene,rays,numRays);
+          for (size_t i=0; i<numRays; i++)
+            if (ivariant & VARIANT_INTERSECT) {
+              if (rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID)
+                return VerifyApplication::FAILED;
+            }
+            else {
+              if (rays[i].ray.tfar != float(neg_inf))
+                return VerifyApplication::FAILED;
+            }
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct IncrementalUpdateTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    IncrementalUpdateTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+
+      /* grid of spheres where only a few spheres move per frame */
+      const size_t numPhi = 10;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      const size_t numSpheres = 64;
+      std::vector<Vec3fa> pos(numSpheres);
+      std::vector<unsigned> geomID(numSpheres);
+      std::vector<bool> enabled(numSpheres,true);
+      for (size_t i=0; i<numSpheres; i++) {
+        pos[i] = Vec3fa(4.0f*float(i%8),0.0f,4.0f*float(i/8));
+        geomID[i] = scene.addSphere(sampler,quality,pos[i],1.0f,numPhi).first;
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t frame=0; frame<32; frame++)
+      {
+        /* small movements keep the top-level hierarchy, large jumps degrade it */
+        for (size_t k=0; k<4; k++)
+        {
+          const size_t i = random_int()%numSpheres;
+          Vec3fa ds(0.1f*(random_float()-0.5f),0.0f,0.1f*(random_float()-0.5f),0.0f);
+          if (frame%8 == 7) ds.y = 20.0f*random_float();
+          UpdateTest::move_mesh(rtcGetGeometry(scene,geomID[i]),numVertices,ds);
+          pos[i] += ds;
+        }
+
+        /* changing the set of geometries requires a full rebuild */
+        if (frame%5 == 4)
+        {
+          const size_t i = random_int()%numSpheres;
+          enabled[i] = !enabled[i];
+          if (enabled[i]) rtcEnableGeometry(rtcGetGeometry(scene,geomID[i]));
+          else            rtcDisableGeometry(rtcGetGeometry(scene,geomID[i]));
+        }
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        for (size_t i=0; i<numSpheres; i++)
+        {
+          RTCRayHit ray = makeRay(pos[i]+Vec3fa(0,30,0),Vec3fa(0,-1,0));
+          rtcIntersect1(scene,&context,&ray);
+          const unsigned int expected = enabled[i] ? geomID[i] : RTC_INVALID_GEOMETRY_ID;
+          if (ray.hit.geomID != expected) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct RangedUpdateTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool quads;
+
+    RangedUpdateTest (std::string name, int isa, SceneFlags sflags, bool quads)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quads(quads) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+
+      /* plane large enough to get refit in parallel, rows of vertices get lifted per frame */
+      const size_t width = 100;
+      const Vec3fa p0(0.0f), dx(float(width),0.0f,0.0f), dy(0.0f,0.0f,float(width));
+      Ref<SceneGraph::Node> node = quads ? SceneGraph::createQuadPlane(p0,dx,dy,width,width) : SceneGraph::createTrianglePlane(p0,dx,dy,width,width);
+      const unsigned int geomID = scene.addGeometry(RTC_BUILD_QUALITY_REFIT,node);
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      std::vector<float> height(width+1,0.0f);
+      for (size_t frame=0; frame<16; frame++)
+      {
+        const size_t row0 = random_int()%(width+1);
+        const size_t row1 = min(row0+1+random_int()%20,width+1);
+        const float h = 5.0f*random_float();
+
+        Vec3fa* vertices = (Vec3fa*) rtcGetGeometryBufferData(geom,RTC_BUFFER_TYPE_VERTEX,0);
+        for (size_t y=row0; y<row1; y++) {
+          height[y] = h;
+          for (size_t x=0; x<=width; x++)
+            vertices[y*(width+1)+x].y = h;
+        }
+        rtcUpdateGeometryBufferRange(geom,RTC_BUFFER_TYPE_VERTEX,0,unsigned(row0*(width+1)),unsigned((row1-row0)*(width+1)));
+        rtcCommitGeometry(geom);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        /* only test cells that are not slanted, and avoid the diagonal edge of the cells */
+        for (size_t y=0; y<width; y++)
+        {
+          if (height[y] != height[y+1]) continue;
+          for (size_t x=0; x<width; x++)
+          {
+            RTCRayHit ray = makeRay(Vec3fa(float(x)+0.3f,10.0f,float(y)+0.4f),Vec3fa(0,-1,0));
+            rtcIntersect1(scene,&context,&ray);
+            if (ray.hit.geomID != geomID) return VerifyApplication::FAILED;
+            if (abs(ray.ray.tfar-(10.0f-height[y])) > 1E-3f) return VerifyApplication::FAILED;
+          }
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct HalfVerticesTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool quads;
+
+    HalfVerticesTest (std::string name, int isa, SceneFlags sflags, bool quads)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quads(quads) {}
+
+    /* converts floats that are exactly representable as half precision floats */
+    static unsigned short toHalf(float f)
+    {
+      unsigned int i; memcpy(&i,&f,sizeof(float));
+      const unsigned int sign = (i >> 16) & 0x8000;
+      if ((i & 0x7fffffff) == 0) return sign;
+      const unsigned int exp = ((i >> 23) & 0xff) - 127 + 15;
+      return (unsigned short) (sign | (exp << 10) | ((i >> 13) & 0x3ff));
+    }
+
+    /* height field of a grid, all coordinates are exactly representable as half precision floats */
+    unsigned int addGrid(RTCDevice device, RTCScene scene, size_t width, bool half)
+    {
+      RTCGeometry geom = rtcNewGeometry(device, quads ? RTC_GEOMETRY_TYPE_QUAD : RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+
+      const size_t numVertices = (width+1)*(width+1);
+      float* vf = half ? nullptr : (float*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,4*sizeof(float),numVertices);
+      unsigned short* vh = half ? (unsigned short*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_HALF3,4*sizeof(unsigned short),numVertices) : nullptr;
+      for (size_t z=0; z<=width; z++) {
+        for (size_t x=0; x<=width; x++) {
+          const size_t i = z*(width+1)+x;
+          const float p[4] = { float(x), 0.25f*float((7*x+3*z)%5), float(z), 0.0f };
+          for (size_t k=0; k<4; k++) {
+            if (half) vh[4*i+k] = toHalf(p[k]);
+            else      vf[4*i+k] = p[k];
+          }
+        }
+      }
+
+      const size_t numPrims = width*width*(quads ? 1 : 2);
+      unsigned int* indices = (unsigned int*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,quads ? RTC_FORMAT_UINT4 : RTC_FORMAT_UINT3,(quads ? 4 : 3)*sizeof(unsigned int),numPrims);
+      for (size_t z=0, j=0; z<width; z++) {
+        for (size_t x=0; x<width; x++) {
+          const unsigned int i00 = unsigned((z+0)*(width+1)+x+0), i01 = unsigned((z+0)*(width+1)+x+1);
+          const unsigned int i10 = unsigned((z+1)*(width+1)+x+0), i11 = unsigned((z+1)*(width+1)+x+1);
+          if (quads) {
+            indices[j++] = i00; indices[j++] = i01; indices[j++] = i11; indices[j++] = i10;
+          } else {
+            indices[j++] = i00; indices[j++] = i01; indices[j++] = i11;
+            indices[j++] = i00; indices[j++] = i11; indices[j++] = i10;
+          }
+        }
+      }
+      rtcCommitGeometry(geom);
+      unsigned int geomID = rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      return geomID;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* the same grid once with single and once with half precision vertices */
+      const size_t width = 16;
+      VerifyScene sceneF(device,sflags);
+      VerifyScene sceneH(device,sflags);
+      addGrid(device,sceneF,width,false);
+      const unsigned int geomID = addGrid(device,sceneH,width,true);
+      rtcCommitScene (sceneF);
+      rtcCommitScene (sceneH);
+      AssertNoError(device);
+      RTCGeometry geom = rtcGetGeometry(sceneH,geomID);
+
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org(float(width)*random_float(),4.0f,float(width)*random_float());
+        const Vec3fa dir(0.2f*random_float()-0.1f,-1.0f,0.2f*random_float()-0.1f);
+        RTCRayHit rayF = makeRay(org,dir); rtcIntersect1(sceneF,&context,&rayF);
+        RTCRayHit rayH = makeRay(org,dir); rtcIntersect1(sceneH,&context,&rayH);
+        if (rayF.hit.geomID != rayH.hit.geomID) return VerifyApplication::FAILED;
+        if (rayH.hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (rayF.hit.primID != rayH.hit.primID) return VerifyApplication::FAILED;
+        if (abs(rayF.ray.tfar-rayH.ray.tfar) > 1E-4f) return VerifyApplication::FAILED;
+        if (abs(rayF.hit.u-rayH.hit.u) > 1E-4f || abs(rayF.hit.v-rayH.hit.v) > 1E-4f) return VerifyApplication::FAILED;
+
+        /* interpolating the vertex buffer has to reproduce the hit point */
+        float P[3];
+        rtcInterpolate0(geom,rayH.hit.primID,rayH.hit.u,rayH.hit.v,RTC_BUFFER_TYPE_VERTEX,0,P,3);
+        const Vec3fa hit = org+rayH.ray.tfar*dir;
+        if (abs(P[0]-hit.x) > 1E-3f || abs(P[1]-hit.y) > 1E-3f || abs(P[2]-hit.z) > 1E-3f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct AsyncCommitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    AsyncCommitTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    struct Completion
+    {
+      Completion () : count(0), errors(0) {}
+      std::atomic<size_t> count;
+      std::atomic<size_t> errors;
+    };
+
+    static void commitCompletion(void* ptr, RTCScene scene, RTCError error)
+    {
+      Completion* completion = (Completion*) ptr;
+      if (error != RTC_ERROR_NONE) completion->errors++;
+      completion->count++;
+    }
+
+    /* returns the height of the plane some ray hits, or -1 if the ray misses */
+    float traceHeight(RTCScene scene, RTCIntersectContext* context)
+    {
+      RTCRayHit ray = makeRay(Vec3fa(10.0f*random_float(),10.0f,10.0f*random_float()),Vec3fa(0,-1,0));
+      rtcIntersect1(scene,context,&ray);
+      if (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) return -1.0f;
+      return 10.0f-ray.ray.tfar;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      Completion completion;
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+
+      /* each scene version adds a plane above all previous ones */
+      const Vec3fa dx(10.0f,0.0f,0.0f), dy(0.0f,0.0f,10.0f);
+      scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(Vec3fa(0.0f),dx,dy,50,50));
+      rtcCommitSceneAsync(scene,commitCompletion,&completion);
+      while (completion.count != 1) yield();
+      if (abs(traceHeight(scene,&context)-0.0f) > 1E-3f) return VerifyApplication::FAILED;
+
+      for (size_t i=1; i<8; i++)
+      {
+        scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(Vec3fa(0.0f,float(i),0.0f),dx,dy,50,50));
+
+        /* sometimes commit synchronously, which also has to keep the scene consistent */
+        if (i == 4) {
+          rtcCommitScene(scene);
+          if (abs(traceHeight(scene,&context)-float(i)) > 1E-3f) return VerifyApplication::FAILED;
+          continue;
+        }
+        const size_t count = completion.count;
+        rtcCommitSceneAsync(scene,commitCompletion,&completion);
+
+        /* ray queries during the build see either the previous or the new version */
+        while (completion.count == count) {
+          const float h = traceHeight(scene,&context);
+          if (abs(h-float(i)) > 1E-3f && abs(h-float(i-1)) > 1E-3f) return VerifyApplication::FAILED;
+        }
+        if (abs(traceHeight(scene,&context)-float(i)) > 1E-3f) return VerifyApplication::FAILED;
+      }
+      if (completion.errors) return VerifyApplication::FAILED;
+
+      /* releasing the scene has to wait for pending commits */
+      scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(Vec3fa(0.0f,8.0f,0.0f),dx,dy,50,50));
+      rtcCommitSceneAsync(scene,commitCompletion,&completion);
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct BuildPriorityTest : public VerifyApplication::Test
+  {
+    BuildPriorityTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* records the threads that compute bounds of user geometries */
+    struct BuildThreads
+    {
+      SpinLock mutex;
+      std::set<std::thread::id> threads;
+    };
+
+    static void boundsFunc(const struct RTCBoundsFunctionArguments* args)
+    {
+      BuildThreads* build = (BuildThreads*) args->geometryUserPtr;
+      {
+        Lock<SpinLock> lock(build->mutex);
+        build->threads.insert(std::this_thread::get_id());
+      }
+      const float x = float(args->primID % 1000), z = float(args->primID / 1000);
+      args->bounds_o->lower_x = x; args->bounds_o->lower_y = 0.0f; args->bounds_o->lower_z = z;
+      args->bounds_o->upper_x = x+1.0f; args->bounds_o->upper_y = 1.0f; args->bounds_o->upper_z = z+1.0f;
+    }
+
+    static void commitCompletion(void* ptr, RTCScene scene, RTCError error) {
+      ((std::atomic<int>*) ptr)->store(error == RTC_ERROR_NONE ? 1 : -1);
+    }
+
+    void createUserScene(const RTCDeviceRef& device, RTCScene scene, BuildThreads* build, unsigned int N)
+    {
+      RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_USER);
+      rtcSetGeometryUserPrimitiveCount(geom,N);
+      rtcSetGeometryUserData(geom,build);
+      rtcSetGeometryBoundsFunction(geom,boundsFunc,nullptr);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* a build limited to the committing thread */
+      BuildThreads build0;
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      createUserScene(device,scene0,&build0,100000);
+      rtcSetSceneBuildThreadLimit(scene0,1);
+      rtcCommitScene(scene0);
+      AssertNoError(device);
+      if (build0.threads.size() != 1) return VerifyApplication::FAILED;
+
+      /* a low priority background build limited to two threads */
+      BuildThreads build1;
+      std::atomic<int> done1(0);
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      createUserScene(device,scene1,&build1,1000000);
+      rtcSetSceneBuildPriority(scene1,-1);
+      rtcSetSceneBuildThreadLimit(scene1,2);
+      rtcCommitSceneAsync(scene1,commitCompletion,&done1);
+
+      /* a high priority build running concurrently */
+      VerifyScene scene2(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene2.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,200));
+      rtcSetSceneBuildPriority(scene2,1);
+      rtcCommitScene(scene2);
+      AssertNoError(device);
+
+      RTCRayHit ray = makeRay(Vec3fa(0.0f,0.0f,-2.0f),Vec3fa(0.0f,0.0f,1.0f));
+      rtcIntersect1(scene2,&context,&ray);
+      if (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID || abs(ray.ray.tfar-1.0f) > 1E-2f) return VerifyApplication::FAILED;
+
+      while (done1 == 0) yield();
+      if (done1 != 1) return VerifyApplication::FAILED;
+      if (build1.threads.size() > 2) return VerifyApplication::FAILED;
+
+      RTCBounds bounds; rtcGetSceneBounds(scene1,&bounds);
+      if (bounds.lower_x != 0.0f || bounds.upper_x != 1000.0f || bounds.upper_z != 1000.0f) return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct UnifiedAccelTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    UnifiedAccelTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    struct UserSphere : public Sphere
+    {
+      UserSphere (const Vec3fa& pos, float r) : Sphere(pos,r), geomID(RTC_INVALID_GEOMETRY_ID) {}
+      unsigned int geomID;
+    };
+
+    static void sphereIntersectFuncN(const struct RTCIntersectFunctionNArguments* const args)
+    {
+      const UserSphere* sphere = (const UserSphere*) args->geometryUserPtr;
+      RTCRayN* rays = RTCRayHitN_RayN(args->rayhit,args->N);
+      RTCHitN* hits = RTCRayHitN_HitN(args->rayhit,args->N);
+      for (unsigned int i=0; i<args->N; i++)
+      {
+        if (args->valid[i] != -1) continue;
+        const Vec3fa org(RTCRayN_org_x(rays,args->N,i),RTCRayN_org_y(rays,args->N,i),RTCRayN_org_z(rays,args->N,i));
+        const Vec3fa dir(RTCRayN_dir_x(rays,args->N,i),RTCRayN_dir_y(rays,args->N,i),RTCRayN_dir_z(rays,args->N,i));
+        const Vec3fa v = org-sphere->pos;
+        const float A = dot(dir,dir), B = 2.0f*dot(v,dir), C = dot(v,v)-sqr(sphere->r);
+        const float D = B*B-4.0f*A*C;
+        if (D < 0.0f) continue;
+        const float t = (-B-sqrt(D))/(2.0f*A);
+        if (t <= RTCRayN_tnear(rays,args->N,i) || t >= RTCRayN_tfar(rays,args->N,i)) continue;
+        const Vec3fa Ng = org+t*dir-sphere->pos;
+        RTCRayN_tfar(rays,args->N,i) = t;
+        RTCHitN_Ng_x(hits,args->N,i) = Ng.x;
+        RTCHitN_Ng_y(hits,args->N,i) = Ng.y;
+        RTCHitN_Ng_z(hits,args->N,i) = Ng.z;
+        RTCHitN_u(hits,args->N,i) = 0.0f;
+        RTCHitN_v(hits,args->N,i) = 0.0f;
+        RTCHitN_primID(hits,args->N,i) = args->primID;
+        RTCHitN_geomID(hits,args->N,i) = sphere->geomID;
+        RTCHitN_instID(hits,args->N,i,0) = args->context->instID[0];
+      }
+    }
+
+    static void sphereOccludedFuncN(const struct RTCOccludedFunctionNArguments* const args)
+    {
+      const Sphere* sphere = (const Sphere*) args->geometryUserPtr;
+      for (unsigned int i=0; i<args->N; i++)
+      {
+        if (args->valid[i] != -1) continue;
+        const Vec3fa org(RTCRayN_org_x(args->ray,args->N,i),RTCRayN_org_y(args->ray,args->N,i),RTCRayN_org_z(args->ray,args->N,i));
+        const Vec3fa dir(RTCRayN_dir_x(args->ray,args->N,i),RTCRayN_dir_y(args->ray,args->N,i),RTCRayN_dir_z(args->ray,args->N,i));
+        const Vec3fa v = org-sphere->pos;
+        const float A = dot(dir,dir), B = 2.0f*dot(v,dir), C = dot(v,v)-sqr(sphere->r);
+        const float D = B*B-4.0f*A*C;
+        if (D < 0.0f) continue;
+        const float t = (-B-sqrt(D))/(2.0f*A);
+        if (t <= RTCRayN_tnear(args->ray,args->N,i) || t >= RTCRayN_tfar(args->ray,args->N,i)) continue;
+        RTCRayN_tfar(args->ray,args->N,i) = neg_inf;
+      }
+    }
+
+    /* plane of triangles, plane of quads, hair, a user geometry sphere, and an instanced sphere */
+    void createScene(const RTCDeviceRef& device, VerifyScene& scene, UserSphere* sphere, RTCScene instScene)
+    {
+      scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(Vec3fa(0.0f,0.0f,0.0f),Vec3fa(5.0f,0.0f,0.0f),Vec3fa(0.0f,0.0f,10.0f),20,40));
+      scene.addGeometry(sflags.qflags,SceneGraph::createQuadPlane(Vec3fa(5.0f,0.0f,0.0f),Vec3fa(5.0f,0.0f,0.0f),Vec3fa(0.0f,0.0f,10.0f),20,40));
+      scene.addGeometry(sflags.qflags,SceneGraph::createHairyPlane(17,Vec3fa(2.0f,0.0f,2.0f),Vec3fa(6.0f,0.0f,0.0f),Vec3fa(0.0f,0.0f,6.0f),0.5f,0.02f,2000,SceneGraph::FLAT_CURVE));
+
+      RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_USER);
+      rtcSetGeometryUserPrimitiveCount(geom,1);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+      rtcSetGeometryUserData(geom,sphere);
+      rtcSetGeometryBoundsFunction(geom,BoundsFunc,nullptr);
+      rtcSetGeometryIntersectFunction(geom,sphereIntersectFuncN);
+      rtcSetGeometryOccludedFunction(geom,sphereOccludedFuncN);
+      rtcCommitGeometry(geom);
+      sphere->geomID = rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+
+      geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(geom,instScene);
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(7.0f,1.0f,7.0f));
+      rtcSetGeometryTransform(geom,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,&xfm);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+    }
+
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
       RTCIntersectContext context;
       rtcInitIntersectContext(&context);
-  
+
       std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
-      VerifyScene scene(device,sflags);
-      AssertNoError(device);
-      unsigned geom0 = scene.addSphere      (sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(-1,0,-1),1.0f,50).first;
-      unsigned geom1 = scene.addQuadSphere  (sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(-1,0,+1),1.0f,50).first;
-      unsigned geom2 = scene.addSubdivSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(+1,0,-1),1.0f,5,4).first;
-      unsigned geom3 = scene.addHair        (sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(+1,0,+1),1.0f,1.0f,1).first;
-      RTCGeometry hgeom0 = rtcGetGeometry(scene,geom0);
-      RTCGeometry hgeom1 = rtcGetGeometry(scene,geom1);
-      RTCGeometry hgeom2 = rtcGetGeometry(scene,geom2);
-      RTCGeometry hgeom3 = rtcGetGeometry(scene,geom3);
+
+      UserSphere sphere(Vec3fa(3.0f,1.0f,6.0f),1.0f);
+      VerifyScene instScene(device,sflags);
+      instScene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(zero,1.0f,20));
+      rtcCommitScene(instScene);
+
+      /* the same scene once with separate and once with a unified acceleration structure */
+      VerifyScene sceneS(device,sflags);
+      VerifyScene sceneU(device,SceneFlags(RTCSceneFlags(sflags.sflags | RTC_SCENE_FLAG_UNIFIED_ACCEL),sflags.qflags));
+      createScene(device,sceneS,&sphere,instScene);
+      createScene(device,sceneU,&sphere,instScene);
+      rtcCommitScene(sceneS);
+      rtcCommitScene(sceneU);
       AssertNoError(device);
-      
-      for (size_t i=0; i<16; i++) 
+
+      for (size_t i=0; i<1000; i+=4)
       {
-        bool enabled0 = i & 1, enabled1 = i & 2, enabled2 = i & 4, enabled3 = i & 8;
-        if (enabled0) rtcEnableGeometry(hgeom0); else rtcDisableGeometry(hgeom0); AssertNoError(device);
-        if (enabled1) rtcEnableGeometry(hgeom1); else rtcDisableGeometry(hgeom1); AssertNoError(device);
-        if (enabled2) rtcEnableGeometry(hgeom2); else rtcDisableGeometry(hgeom2); AssertNoError(device);
-        if (enabled3) rtcEnableGeometry(hgeom3); else rtcDisableGeometry(hgeom3); AssertNoError(device);
-        rtcCommitScene (scene);
-        AssertNoError(device);
+        RTCRayHit rays[4];
+        RTCRayHit4 ray4;
+        for (size_t j=0; j<4; j++) {
+          const Vec3fa org(10.0f*random_float(),4.0f,10.0f*random_float());
+          const Vec3fa dir(random_float()-0.5f,-1.0f,random_float()-0.5f);
+          rays[j] = makeRay(org,dir);
+          setRay(ray4,j,rays[j]);
+        }
+        __aligned(16) int valid4[4] = { -1,-1,-1,-1 };
+        rtcIntersect4(valid4,sceneU,&context,&ray4);
+
+        for (size_t j=0; j<4; j++)
         {
-          RTCRayHit ray0 = makeRay(Vec3fa(-1,10,-1),Vec3fa(0,-1,0));
-          RTCRayHit ray1 = makeRay(Vec3fa(-1,10,+1),Vec3fa(0,-1,0)); 
-          RTCRayHit ray2 = makeRay(Vec3fa(+1,10,-1),Vec3fa(0,-1,0)); 
-          RTCRayHit ray3 = makeRay(Vec3fa(+1,10,+1),Vec3fa(0,-1,0)); 
-          rtcIntersect1(scene,&context,&ray0);
-          rtcIntersect1(scene,&context,&ray1);
-          rtcIntersect1(scene,&context,&ray2);
-          rtcIntersect1(scene,&context,&ray3);
-          bool ok0 = enabled0 ? ray0.hit.geomID == 0 : ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID;
-          bool ok1 = enabled1 ? ray1.hit.geomID == 1 : ray1.hit.geomID == RTC_INVALID_GEOMETRY_ID;
-          bool ok2 = enabled2 ? ray2.hit.geomID == 2 : ray2.hit.geomID == RTC_INVALID_GEOMETRY_ID;
-          bool ok3 = enabled3 ? ray3.hit.geomID == 3 : ray3.hit.geomID == RTC_INVALID_GEOMETRY_ID;
-          if (!ok0 || !ok1 || !ok2 || !ok3) return VerifyApplication::FAILED;
+          RTCRayHit rayS = rays[j]; rtcIntersect1(sceneS,&context,&rayS);
+          RTCRayHit rayU = rays[j]; rtcIntersect1(sceneU,&context,&rayU);
+          RTCRayHit rayK = getRay(ray4,j);
+          if (rayS.hit.geomID != rayU.hit.geomID || rayS.hit.geomID != rayK.hit.geomID) return VerifyApplication::FAILED;
+          if (rayS.hit.instID[0] != rayU.hit.instID[0] || rayS.hit.instID[0] != rayK.hit.instID[0]) return VerifyApplication::FAILED;
+          if (abs(rayS.ray.tfar-rayU.ray.tfar) > 1E-3f || abs(rayS.ray.tfar-rayK.ray.tfar) > 1E-3f) return VerifyApplication::FAILED;
+
+          RTCRay shadowS = rays[j].ray; rtcOccluded1(sceneS,&context,&shadowS);
+          RTCRay shadowU = rays[j].ray; rtcOccluded1(sceneU,&context,&shadowU);
+          if ((shadowS.tfar == float(neg_inf)) != (shadowU.tfar == float(neg_inf))) return VerifyApplication::FAILED;
         }
       }
       AssertNoError(device);
@@ -1641,81 +2667,77 @@ namespace embree
       return VerifyApplication::PASSED;
     }
   };
-  
-  struct UpdateTest : public VerifyApplication::IntersectTest
+
+  struct NumaReplicateTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
-    RTCBuildQuality quality;
 
-    UpdateTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
-      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
-    
-    static void move_mesh(RTCGeometry mesh, size_t numVertices, Vec3fa& pos) 
+    NumaReplicateTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* plane of triangles, plane of quads, hair, and an instanced sphere */
+    void createScene(const RTCDeviceRef& device, VerifyScene& scene, RTCScene instScene)
     {
-      Vec3fa* vertices = (Vec3fa*) rtcGetGeometryBufferData(mesh,RTC_BUFFER_TYPE_VERTEX,0);
-      for (size_t i=0; i<numVertices; i++)
-        vertices[i] += Vec3fa(pos);
-      rtcUpdateGeometryBuffer(mesh,RTC_BUFFER_TYPE_VERTEX,0);
-      rtcCommitGeometry(mesh);
+      scene.addGeometry(sflags.qflags,SceneGraph::createTrianglePlane(Vec3fa(0.0f,0.0f,0.0f),Vec3fa(5.0f,0.0f,0.0f),Vec3fa(0.0f,0.0f,10.0f),20,40));
+      scene.addGeometry(sflags.qflags,SceneGraph::createQuadPlane(Vec3fa(5.0f,0.0f,0.0f),Vec3fa(5.0f,0.0f,0.0f),Vec3fa(0.0f,0.0f,10.0f),20,40));
+      scene.addGeometry(sflags.qflags,SceneGraph::createHairyPlane(17,Vec3fa(2.0f,0.0f,2.0f),Vec3fa(6.0f,0.0f,0.0f),Vec3fa(0.0f,0.0f,6.0f),0.5f,0.02f,2000,SceneGraph::FLAT_CURVE));
+
+      RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(geom,instScene);
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(7.0f,1.0f,7.0f));
+      rtcSetGeometryTransform(geom,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,&xfm);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
     }
 
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
       std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
-      if (!supportsIntersectMode(device,imode))
-        return VerifyApplication::SKIPPED;
-      
-      VerifyScene scene(device,sflags);
-      AssertNoError(device);
-      size_t numPhi = 10;
-      size_t numVertices = 2*numPhi*(numPhi+1);
-      Vec3fa pos0 = Vec3fa(-10,0,-10);
-      Vec3fa pos1 = Vec3fa(-10,0,+10);
-      Vec3fa pos2 = Vec3fa(+10,0,-10);
-      Vec3fa pos3 = Vec3fa(+10,0,+10);
-      unsigned geom0 = scene.addSphere      (sampler,quality,pos0,1.0f,numPhi).first;
-      unsigned geom1 = scene.addQuadSphere  (sampler,quality,pos1,1.0f,numPhi).first;
-      unsigned geom2 = scene.addSubdivSphere(sampler,quality,pos2,1.0f,numPhi,4).first;
-      unsigned geom3 = scene.addSphereHair  (sampler,quality,pos3,1.0f).first;
-      RTCGeometry hgeom0 = rtcGetGeometry(scene,geom0);
-      RTCGeometry hgeom1 = rtcGetGeometry(scene,geom1);
-      RTCGeometry hgeom2 = rtcGetGeometry(scene,geom2);
-      RTCGeometry hgeom3 = rtcGetGeometry(scene,geom3);
+
+      VerifyScene instScene(device,sflags);
+      instScene.addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(zero,1.0f,20));
+      rtcCommitScene(instScene);
+
+      /* the same scene once without and once with per NUMA node replicas */
+      VerifyScene sceneS(device,sflags);
+      VerifyScene sceneR(device,SceneFlags(RTCSceneFlags(sflags.sflags | RTC_SCENE_FLAG_NUMA_REPLICATE),sflags.qflags));
+      createScene(device,sceneS,instScene);
+      createScene(device,sceneR,instScene);
+      rtcCommitScene(sceneS);
+      rtcCommitScene(sceneR);
       AssertNoError(device);
-      
-      for (size_t i=0; i<16; i++) 
-      {
-        bool move0 = i & 1, move1 = i & 2, move2 = i & 4, move3 = i & 8;
-        Vec3fa ds(2,0.1f,2,0.0f);
-        if (move0) { move_mesh(hgeom0,numVertices,ds); pos0 += ds; }
-        if (move1) { move_mesh(hgeom1,numVertices,ds); pos1 += ds; }
-        if (move2) { move_mesh(hgeom2,numVertices,ds); pos2 += ds; }
-        if (move3) { move_mesh(hgeom3,4,ds); pos3 += ds; }
-        rtcCommitScene (scene);
-        AssertNoError(device);
 
-        RTCRayHit ray0 = makeRay(pos0+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 0
-        RTCRayHit ray1 = makeRay(pos1+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 1
-        RTCRayHit ray2 = makeRay(pos2+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 2
-        RTCRayHit ray3 = makeRay(pos3+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 3
-        RTCRayHit testRays[4] = { ray0, ray1, ray2, ray3 };
+      for (size_t i=0; i<1000; i+=4)
+      {
+        RTCRayHit rays[4];
+        RTCRayHit4 ray4;
+        for (size_t j=0; j<4; j++) {
+          const Vec3fa org(10.0f*random_float(),4.0f,10.0f*random_float());
+          const Vec3fa dir(random_float()-0.5f,-1.0f,random_float()-0.5f);
+          rays[j] = makeRay(org,dir);
+          setRay(ray4,j,rays[j]);
+        }
+        __aligned(16) int valid4[4] = { -1,-1,-1,-1 };
+        rtcIntersect4(valid4,sceneR,&context,&ray4);
 
-        const unsigned int maxRays = 100;
-        RTCRayHit rays[maxRays];
-        for (unsigned int numRays=1; numRays<maxRays; numRays++) {
-          for (size_t i=0; i<numRays; i++) rays[i] = testRays[i%4];
-          IntersectWithMode(imode,ivariant,scene,rays,numRays);
-          for (size_t i=0; i<numRays; i++)
-            if (ivariant & VARIANT_INTERSECT) {
-              if (rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID)
-                return VerifyApplication::FAILED;
-            }
-            else {
-              if (rays[i].ray.tfar != float(neg_inf))
-                return VerifyApplication::FAILED;
-            }
+        for (size_t j=0; j<4; j++)
+        {
+          RTCRayHit rayS = rays[j]; rtcIntersect1(sceneS,&context,&rayS);
+          RTCRayHit rayR = rays[j]; rtcIntersect1(sceneR,&context,&rayR);
+          RTCRayHit rayK = getRay(ray4,j);
+          if (rayS.hit.geomID != rayR.hit.geomID || rayS.hit.geomID != rayK.hit.geomID) return VerifyApplication::FAILED;
+          if (rayS.hit.instID[0] != rayR.hit.instID[0] || rayS.hit.instID[0] != rayK.hit.instID[0]) return VerifyApplication::FAILED;
+          if (abs(rayS.ray.tfar-rayR.ray.tfar) > 1E-3f || abs(rayS.ray.tfar-rayK.ray.tfar) > 1E-3f) return VerifyApplication::FAILED;
+
+          RTCRay shadowS = rays[j].ray; rtcOccluded1(sceneS,&context,&shadowS);
+          RTCRay shadowR = rays[j].ray; rtcOccluded1(sceneR,&context,&shadowR);
+          if ((shadowS.tfar == float(neg_inf)) != (shadowR.tfar == float(neg_inf))) return VerifyApplication::FAILED;
         }
       }
       AssertNoError(device);
@@ -1990,6 +3012,56 @@ namespace embree
     }
   };
 
+  struct TessellationCacheTest : public VerifyApplication::Test
+  {
+    TessellationCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED))
+        return VerifyApplication::SKIPPED;
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned geomID = scene.addSubdivSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,8,4).first;
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+
+      /* the cache is shared by all devices, thus enlarge it to make this device control the size */
+      const ssize_t size = 2*rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE);
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE,size);
+      AssertNoError(device);
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE) != size) 
+        return VerifyApplication::FAILED;
+
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS,0);
+      AssertNoError(device);
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS) != 0) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES) != 0) return VerifyApplication::FAILED;
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES) != 0) return VerifyApplication::FAILED;
+
+      /* the first interpolation builds the patches, the second one finds them in the cache */
+      float P[3], dPdu[3], dPdv[3];
+      for (unsigned int i=0; i<2; i++)
+        for (unsigned int primID=0; primID<16; primID++)
+          rtcInterpolate1(geom,primID,0.5f,0.5f,RTC_BUFFER_TYPE_VERTEX,0,P,dPdu,dPdv,3);
+      AssertNoError(device);
+
+      const ssize_t hits   = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS);
+      const ssize_t misses = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES);
+      const ssize_t bytes  = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_BYTES_USED);
+      AssertNoError(device);
+      if (hits != 16 || misses != 16 || bytes <= 0 || bytes > size)
+        return VerifyApplication::FAILED;
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct InterpolateTrianglesTest : public VerifyApplication::Test
   {
     size_t N;
@@ -2439,6 +3511,106 @@ namespace embree
     }
   };
   
+  struct InstanceLevelsTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    unsigned int levels;
+
+    InstanceLevelsTest (std::string name, int isa, SceneFlags sflags, unsigned int levels, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), levels(levels) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      Vec3f vertices[4] = {
+        Vec3f(0.0f,0.0f,0.0f),
+        Vec3f(1.0f,0.0f,0.0f),
+        Vec3f(0.0f,1.0f,0.0f),
+        Vec3f(zero) // dummy vertex for 16 byte padding
+      };
+      Triangle triangles[1] = {
+        Triangle(0,1,2)
+      };
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices , 0, sizeof(Vec3f), 3);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT3,  triangles, 0, sizeof(Triangle), 1);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* instance the triangle scene recursively, each level with its own transformation and instance ID */
+      AffineSpace3fa local2world = one;
+      for (unsigned int l=0; l<levels; l++)
+      {
+        const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(float(l),1.0f,0.0f))*AffineSpace3fa::scale(Vec3fa(2.0f));
+        RTCSceneRef parent = rtcNewScene(device);
+        rtcSetSceneFlags(parent,sflags.sflags);
+        rtcSetSceneBuildQuality(parent,sflags.qflags);
+        RTCGeometry inst = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,scene);
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,&xfm);
+        rtcCommitGeometry(inst);
+        rtcAttachGeometryByID(parent,inst,levels-l);
+        rtcReleaseGeometry(inst);
+        rtcCommitScene(parent);
+        scene = parent;
+        local2world = xfm*local2world;
+      }
+      AssertNoError(device);
+
+      float u[256], v[256];
+      RTCRayHit rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        u[i] = random_float(); 
+        v[i] = random_float();
+        if (u[i] < 0.001f || v[i] < 0.001f || (u[i]+v[i]) > 0.999f) { u[i] = 0.333f; v[i] = 0.333f; } // avoid hitting edges
+        const Vec3fa from = xfmPoint(local2world,Vec3fa(0.0f,0.0f,-1.0f));
+        const Vec3fa to = xfmPoint(local2world,vertices[0] + u[i]*(vertices[1]-vertices[0]) + v[i]*(vertices[2]-vertices[0]));
+        rays[i] = makeRay(from,to-from);
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      /* instances nested deeper than the supported number of instance levels are not hit */
+      const bool hit = levels <= RTC_MAX_INSTANCE_LEVEL_COUNT;
+      for (size_t i=0; i<256; i++)
+      {
+        if (!(ivariant & VARIANT_INTERSECT))
+        {
+          if ((rays[i].ray.tfar == float(neg_inf)) != hit) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (!hit) {
+          if (rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (rays[i].hit.geomID != 0) return VerifyApplication::FAILED;
+        if (rays[i].hit.primID != 0) return VerifyApplication::FAILED;
+        for (unsigned int l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+          const unsigned int instID = l < levels ? l+1 : RTC_INVALID_GEOMETRY_ID;
+          if (rays[i].hit.instID[l] != instID) return VerifyApplication::FAILED;
+        }
+        if (abs(rays[i].hit.u - u[i]) > 1E-4f) return VerifyApplication::FAILED;
+        if (abs(rays[i].hit.v - v[i]) > 1E-4f) return VerifyApplication::FAILED;
+        if (abs(rays[i].ray.tfar - 1.0f) > 1E-4f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct RayMasksTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags; 
@@ -3793,6 +4965,7 @@ namespace embree
       RTCIntersectContext context;
       rtcInitIntersectContext(&context);
       context.flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT :  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+      if (ivariant & VARIANT_SORTED) context.flags = RTC_INTERSECT_CONTEXT_FLAG_SORT;
 
       switch (imode) 
       {
@@ -3962,6 +5135,7 @@ namespace embree
       RTCIntersectContext context;
       rtcInitIntersectContext(&context);
       context.flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT :  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+      if (ivariant & VARIANT_SORTED) context.flags = RTC_INTERSECT_CONTEXT_FLAG_SORT;
 
       RandomSampler sampler;
       RandomSampler_init(sampler, (int)i);
@@ -4253,6 +5427,8 @@ namespace embree
     intersectVariants.push_back(VARIANT_INTERSECT_INCOHERENT);
     intersectVariants.push_back(VARIANT_OCCLUDED_INCOHERENT);
     intersectVariants.push_back(VARIANT_INTERSECT_OCCLUDED_COHERENT);
+    intersectVariants.push_back(VARIANT_INTERSECT_SORTED);
+    intersectVariants.push_back(VARIANT_OCCLUDED_SORTED);
 
     /* create list of all scene flags to test */
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_NONE,       RTC_BUILD_QUALITY_MEDIUM));
@@ -4295,6 +5471,10 @@ namespace embree
       const char* testName = (const char*) rtcGetDeviceProperty(device,(RTCDeviceProperty)i);
       if (testName == nullptr) break;
       groups.top()->add(new EmbreeInternalTest(testName,i-2000000));
+
+      /* also test the tessellation cache split into multiple partitions */
+      if (std::string(testName) == "cache_regression_test")
+        groups.top()->add(new EmbreeInternalTest("cache_regression_test_partitioned",i-2000000,",tessellation_cache_size=256,tessellation_cache_partitions=4"));
     }
     groups.top()->add(new os_shrink_test());
 
@@ -4315,6 +5495,12 @@ namespace embree
       groups.pop();
       
       groups.top()->add(new GetUserDataTest("get_user_data",isa));
+      groups.top()->add(new RayStatisticsTest("ray_statistics",isa));
+
+      push(new TestGroup("numa_policy",true,true));
+      for (auto policy : { "default", "local", "interleave", "replicate" })
+        groups.top()->add(new NumaPolicyTest(policy,isa,policy));
+      groups.pop();
 
       push(new TestGroup("buffer_stride",true,true));
       for (auto gtype : gtypes)
@@ -4345,6 +5531,26 @@ namespace embree
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
       groups.pop();
       
+      push(new TestGroup("bvh_cache",true,true));
+      for (auto sflags : sceneFlags)
+        if (!(sflags.sflags & RTC_SCENE_FLAG_DYNAMIC))
+          groups.top()->add(new BVHCacheTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("point_query",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,false));
+        groups.top()->add(new PointQueryTest(to_string(sflags)+".instancing",isa,sflags,true));
+      }
+      groups.pop();
+
+      push(new TestGroup("collide",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new CollideTest(to_string(sflags),isa,sflags,false));
+        groups.top()->add(new CollideTest(to_string(sflags)+".self",isa,sflags,true));
+      }
+      groups.pop();
+
       push(new TestGroup("overlapping_primitives",true,false));
       for (auto sflags : sceneFlags)
         groups.top()->add(new OverlappingGeometryTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,clamp(int(intensity*10000),1000,100000)));
@@ -4378,6 +5584,46 @@ namespace embree
       }
       groups.pop();
 
+      push(new TestGroup("incremental_update",true,true));
+      for (auto sflags : sceneFlagsDynamic) {
+        groups.top()->add(new IncrementalUpdateTest("deformable."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_REFIT));
+        groups.top()->add(new IncrementalUpdateTest("dynamic."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_LOW));
+      }
+      groups.pop();
+
+      push(new TestGroup("ranged_update",true,true));
+      for (auto sflags : sceneFlagsDynamic) {
+        groups.top()->add(new RangedUpdateTest("triangles."+to_string(sflags),isa,sflags,false));
+        groups.top()->add(new RangedUpdateTest("quads."+to_string(sflags),isa,sflags,true));
+      }
+      groups.pop();
+
+      push(new TestGroup("half_vertices",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new HalfVerticesTest("triangles."+to_string(sflags),isa,sflags,false));
+        groups.top()->add(new HalfVerticesTest("quads."+to_string(sflags),isa,sflags,true));
+      }
+      groups.pop();
+
+      push(new TestGroup("async_commit",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new AsyncCommitTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+#if defined(TASKING_INTERNAL) // thread limits are only supported by the internal tasking system
+      groups.top()->add(new BuildPriorityTest("build_priority",isa));
+#endif
+
+      push(new TestGroup("unified_accel",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new UnifiedAccelTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("numa_replicate",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new NumaReplicateTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
 #if !defined(TASKING_PPL) // FIXME: PPL has some issues here!
       groups.top()->add(new GarbageGeometryTest("build_garbage_geom",isa));
 #endif
@@ -4421,6 +5667,8 @@ namespace embree
       for (auto s : interpolateTests)
         groups.top()->add(new InterpolateSubdivTest(std::to_string((long long)(s)),isa,s));
       groups.pop();
+
+      groups.top()->add(new TessellationCacheTest("tessellation_cache",isa));
         
       push(new TestGroup("hair",true,true));
       for (auto s : interpolateTests) 
@@ -4449,6 +5697,19 @@ namespace embree
                 groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("instance_levels",true,true));
+      for (unsigned int levels=1; levels<=RTC_MAX_INSTANCE_LEVEL_COUNT+1; levels++)
+      {
+        push(new TestGroup(std::to_string(levels),true,true));
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new InstanceLevelsTest(to_string(sflags,imode,ivariant),isa,sflags,levels,imode,ivariant));
+        groups.pop();
+      }
+      groups.pop();
+
       if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_RAY_MASK_SUPPORTED)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -4645,6 +5906,8 @@ namespace embree
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT16,VARIANT_OCCLUDED));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_INTERSECT_INCOHERENT));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_OCCLUDED_INCOHERENT));
+      benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_INTERSECT_SORTED));
+      benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_OCCLUDED_SORTED));
 
       GeometryType benchmark_gtypes[] = { 
         TRIANGLE_MESH, 